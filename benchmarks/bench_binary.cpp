@@ -0,0 +1,93 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/json.hpp"
+
+struct BBase
+{
+  virtual ~BBase() = default;
+};
+
+EZ_JSON_DECLARE(BBase);
+EZ_JSON_DEFINE(BBase);
+
+struct BName : public BBase
+{
+  explicit BName(std::string && n) : name(std::move(n)) {}
+
+  std::string name;
+};
+
+struct BPoints : public BBase
+{
+  explicit BPoints(std::vector<double> && p) : points(std::move(p)) {}
+
+  std::vector<double> points;
+};
+
+struct BGroup : public BBase
+{
+  explicit BGroup(std::vector<std::unique_ptr<BBase>> && c) : children(std::move(c)) {}
+
+  std::vector<std::unique_ptr<BBase>> children;
+};
+
+EZ_JSON_REGISTER(BBase, "name", BName, std::string);
+EZ_JSON_REGISTER(BBase, "points", BPoints, std::vector<double>);
+EZ_JSON_REGISTER(BBase, "group", BGroup, std::vector<std::unique_ptr<BBase>>);
+
+/// @brief Config with n groups of a name and a few points each.
+static std::string MakeConfig(std::size_t n)
+{
+  std::string ret = R"({"group": [)";
+  for (auto i = 0u; i < n; ++i) {
+    ret += (i > 0 ? ", " : "");
+    ret += R"({"group": [{"name": "object_)" + std::to_string(i) + R"("}, {"points": [)";
+    for (auto j = 0u; j < 8; ++j) { ret += (j > 0 ? ", " : "") + std::to_string(0.25 * (i + j)); }
+    ret += "]}]}";
+  }
+  return ret + "]}";
+}
+
+TEST_CASE("BinaryFormats")
+{
+  const std::vector<std::pair<std::string, ezconfig::json::BinaryFormat>> formats{
+    {"cbor", ezconfig::json::BinaryFormat::Cbor},
+    {"msgpack", ezconfig::json::BinaryFormat::MsgPack},
+    {"bson", ezconfig::json::BinaryFormat::Bson},
+    {"ubjson", ezconfig::json::BinaryFormat::UbJson},
+  };
+
+  for (const std::size_t n : {10u, 1'000u, 100'000u}) {
+    const auto config = MakeConfig(n);
+    const auto json   = nlohmann::json::parse(config);
+
+    std::vector<std::vector<std::uint8_t>> data;
+    std::cout << "n = " << n << ": text " << config.size() << " bytes";
+    for (const auto & [name, format] : formats) {
+      data.push_back(ezconfig::json::ToBinary(json, format));
+      std::cout << ", " << name << " " << data.back().size() << " bytes";
+    }
+    std::cout << std::endl;
+
+    BENCHMARK("text " + std::to_string(n))
+    {
+      return ezconfig::json::Create<BBase>(nlohmann::json::parse(config));
+    };
+
+    for (auto i = 0u; i < formats.size(); ++i) {
+      BENCHMARK(formats[i].first + " " + std::to_string(n))
+      {
+        return ezconfig::json::CreateFromBinary<BBase>(data[i], formats[i].second);
+      };
+    }
+  }
+}
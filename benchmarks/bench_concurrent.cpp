@@ -0,0 +1,41 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/factory.hpp"
+
+struct BBase
+{
+  virtual ~BBase() = default;
+};
+
+TEST_CASE("ConcurrentCreateThroughput")
+{
+  static constexpr std::size_t kTags         = 100;
+  static constexpr std::size_t kCallsPerRead = 100'000;
+
+  ezconfig::Factory<BBase> factory;
+  std::vector<std::string> tags;
+  for (auto i = 0u; i < kTags; ++i) {
+    tags.push_back("!some_registered_tag_" + std::to_string(i));
+    factory.add(tags.back(), [] { return std::unique_ptr<BBase>{}; });
+  }
+
+  // each sample performs kCallsPerRead creates per reader thread
+  for (const std::size_t readers : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+    BENCHMARK("create x " + std::to_string(kCallsPerRead) + " with " + std::to_string(readers) + " readers")
+    {
+      std::vector<std::jthread> threads;
+      for (auto r = 0u; r < readers; ++r) {
+        threads.emplace_back([&, r] {
+          for (auto k = 0u; k < kCallsPerRead; ++k) { factory.create(tags[(r + 7 * k) % kTags]); }
+        });
+      }
+    };
+  }
+}
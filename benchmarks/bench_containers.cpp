@@ -0,0 +1,49 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/yaml_types/stl.hpp"
+
+/// @brief Decoding with two key conversions per entry and without reserving.
+static std::unordered_map<std::string, double> DecodeTwice(const YAML::Node & yaml)
+{
+  std::unordered_map<std::string, double> ret;
+  for (const auto & node : yaml) {
+    const auto key = node.first.as<std::string>();
+    if (ret.contains(key)) { throw YAML::ParserException(yaml.Mark(), "Double key '" + key + "' in map"); }
+    ret[node.first.as<std::string>()] = node.second.as<double>();
+  }
+  return ret;
+}
+
+TEST_CASE("Map100k")
+{
+  std::string yaml_str;
+  for (auto i = 0u; i < 100000; ++i) { yaml_str += "key" + std::to_string(i) + ": " + std::to_string(i * 0.5) + "\n"; }
+  const auto yaml = YAML::Load(yaml_str);
+
+  BENCHMARK("unordered_map two conversions")
+  {
+    return DecodeTwice(yaml);
+  };
+
+  BENCHMARK("unordered_map")
+  {
+    return yaml.as<std::unordered_map<std::string, double>>();
+  };
+
+  BENCHMARK("map yaml-cpp")
+  {
+    return yaml.as<std::map<std::string, double>>();
+  };
+
+  BENCHMARK("map As")
+  {
+    return ezconfig::yaml::As<std::map<std::string, double>>(yaml);
+  };
+}
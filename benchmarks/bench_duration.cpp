@@ -0,0 +1,66 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/yaml_types/stl.hpp"
+
+static constexpr std::size_t kDurations = 10000;
+
+/// @brief Decoding with a string copy, suffix tests, and std::stoi.
+static std::chrono::nanoseconds DecodeSuffix(const YAML::Node & yaml)
+{
+  using namespace std::chrono;
+  const auto str = yaml.as<std::string>();
+  if (str.ends_with("ms")) { return milliseconds(std::stoi(str.substr(0, str.size() - 2))); }
+  if (str.ends_with("us")) { return microseconds(std::stoi(str.substr(0, str.size() - 2))); }
+  if (str.ends_with("ns")) { return nanoseconds(std::stoi(str.substr(0, str.size() - 2))); }
+  if (str.ends_with("s")) { return seconds(std::stoi(str.substr(0, str.size() - 1))); }
+  if (str.ends_with("m")) { return minutes(std::stoi(str.substr(0, str.size() - 1))); }
+  if (str.ends_with("h")) { return hours(std::stoi(str.substr(0, str.size() - 1))); }
+  throw YAML::ParserException(yaml.Mark(), "Could not detect suffix");
+}
+
+/// @brief Print decoding throughput in durations per second.
+template<typename F>
+static void PrintThroughput(const std::string & name, F && f)
+{
+  const auto t0 = std::chrono::steady_clock::now();
+  auto n        = 0u;
+  for (; n < 10; ++n) { f(); }
+  const std::chrono::duration<double> t = std::chrono::steady_clock::now() - t0;
+  std::cout << name << ": " << static_cast<double>(n * kDurations) / t.count() / 1e6 << " M durations/s\n";
+}
+
+TEST_CASE("Duration")
+{
+  const char * units[] = {"h", "m", "s", "ms", "us", "ns"};
+  std::string yaml_str = "[";
+  for (auto i = 0u; i < kDurations; ++i) { yaml_str += (i > 0 ? ", " : "") + std::to_string(i) + units[i % 6]; }
+  const auto yaml = YAML::Load(yaml_str + "]");
+
+  const auto suffix = [&] {
+    std::vector<std::chrono::nanoseconds> ret;
+    for (const auto & item : yaml) { ret.push_back(DecodeSuffix(item)); }
+    return ret;
+  };
+  const auto single_pass = [&] { return yaml.as<std::vector<std::chrono::nanoseconds>>(); };
+
+  PrintThroughput("suffix tests", suffix);
+  PrintThroughput("single pass", single_pass);
+
+  BENCHMARK("suffix tests")
+  {
+    return suffix();
+  };
+
+  BENCHMARK("single pass")
+  {
+    return single_pass();
+  };
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/yaml_types/eigen.hpp"
+
+/// @brief Decoding via intermediate std::vector.
+static Eigen::MatrixXd DecodeVectors(const YAML::Node & yaml)
+{
+  const auto data = yaml.as<std::vector<std::vector<double>>>();
+  Eigen::MatrixXd ret(static_cast<Eigen::Index>(data.size()), static_cast<Eigen::Index>(data[0].size()));
+  for (auto i = 0u; const auto & row : data) {
+    ret.row(i++) = Eigen::Map<const Eigen::RowVectorXd>(row.data(), static_cast<Eigen::Index>(row.size()));
+  }
+  return ret;
+}
+
+TEST_CASE("EigenFixed")
+{
+  const auto yaml = YAML::Load("[1.5, -2.25, 3.125]");
+
+  BENCHMARK("via std::vector")
+  {
+    const auto data = yaml.as<std::vector<double>>();
+    return Eigen::Vector3d{Eigen::Map<const Eigen::Vector3d>(data.data())};
+  };
+
+  BENCHMARK("direct")
+  {
+    return yaml.as<Eigen::Vector3d>();
+  };
+}
+
+TEST_CASE("EigenDynamic")
+{
+  std::string yaml_str;
+  for (auto i = 0u; i < 10000; ++i) {
+    yaml_str += "- [";
+    for (auto j = 0u; j < 6; ++j) { yaml_str += (j > 0 ? ", " : "") + std::to_string(i * 0.5 + j); }
+    yaml_str += "]\n";
+  }
+  const auto yaml = YAML::Load(yaml_str);
+
+  BENCHMARK("via std::vector")
+  {
+    return DecodeVectors(yaml);
+  };
+
+  BENCHMARK("direct")
+  {
+    return yaml.as<Eigen::MatrixXd>();
+  };
+}
@@ -0,0 +1,91 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/yaml_types/enum.hpp"
+
+static constexpr std::size_t kEnums = 10000;
+
+// enum with 300 values Msg000 to Msg299
+#define MSG10(p) p##0, p##1, p##2, p##3, p##4, p##5, p##6, p##7, p##8, p##9
+#define MSG100(p) \
+  MSG10(p##0), MSG10(p##1), MSG10(p##2), MSG10(p##3), MSG10(p##4), MSG10(p##5), MSG10(p##6), MSG10(p##7), \
+    MSG10(p##8), MSG10(p##9)
+
+enum class MessageType { MSG100(Msg0), MSG100(Msg1), MSG100(Msg2) };
+
+#undef MSG100
+#undef MSG10
+
+template<>
+struct magic_enum::customize::enum_range<MessageType>
+{
+  static constexpr int min = 0;
+  static constexpr int max = 300;
+};
+
+/// @brief Decoding with a string copy and magic_enum::enum_cast.
+static MessageType DecodeEnumCast(const YAML::Node & yaml)
+{
+  const auto maybe_val = magic_enum::enum_cast<MessageType>(yaml.as<std::string>());
+  if (!maybe_val.has_value()) { throw YAML::ParserException(yaml.Mark(), "Unknown enum name"); }
+  return maybe_val.value();
+}
+
+/// @brief Print decoding throughput in enums per second.
+template<typename F>
+static void PrintThroughput(const std::string & name, F && f)
+{
+  const auto t0 = std::chrono::steady_clock::now();
+  auto n        = 0u;
+  for (; n < 10; ++n) { f(); }
+  const std::chrono::duration<double> t = std::chrono::steady_clock::now() - t0;
+  std::cout << name << ": " << static_cast<double>(n * kEnums) / t.count() / 1e6 << " M enums/s\n";
+}
+
+TEST_CASE("Enum")
+{
+  static_assert(magic_enum::enum_count<MessageType>() == 300);
+
+  std::vector<MessageType> values;
+  for (auto i = 0u; i < kEnums; ++i) { values.push_back(static_cast<MessageType>((i * 7919) % 300)); }
+  YAML::Node yaml;
+  for (const auto val : values) { yaml.push_back(val); }
+  yaml = YAML::Load(YAML::Dump(yaml));
+
+  const auto enum_cast = [&] {
+    std::vector<MessageType> ret;
+    for (const auto & item : yaml) { ret.push_back(DecodeEnumCast(item)); }
+    return ret;
+  };
+  const auto table = [&] { return yaml.as<std::vector<MessageType>>(); };
+
+  REQUIRE(enum_cast() == values);
+  REQUIRE(table() == values);
+
+  PrintThroughput("enum_cast", enum_cast);
+  PrintThroughput("perfect hash", table);
+
+  BENCHMARK("enum_cast")
+  {
+    return enum_cast();
+  };
+
+  BENCHMARK("perfect hash")
+  {
+    return table();
+  };
+
+  BENCHMARK("encode")
+  {
+    YAML::Node ret;
+    for (const auto val : values) { ret.push_back(val); }
+    return ret;
+  };
+}
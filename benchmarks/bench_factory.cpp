@@ -0,0 +1,91 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/factory.hpp"
+
+struct BBase
+{
+  virtual ~BBase() = default;
+};
+
+using BFactory = ezconfig::Factory<BBase>;
+
+namespace {
+
+std::vector<std::string> make_tags(std::size_t n)
+{
+  std::vector<std::string> tags;
+  for (auto i = 0u; i < n; ++i) { tags.push_back("!some_registered_tag_" + std::to_string(i)); }
+  return tags;
+}
+
+}  // namespace
+
+TEST_CASE("FactoryLookup")
+{
+  for (const std::size_t n : {10u, 100u, 1000u}) {
+    const auto tags = make_tags(n);
+
+    // baseline: tag map as used before the flat hash table
+    std::map<std::string, BFactory::GeneratorT> map;
+    BFactory factory, frozen;
+    for (const auto & tag : tags) {
+      map[tag] = [] { return std::unique_ptr<BBase>{}; };
+      factory.add(tag, [] { return std::unique_ptr<BBase>{}; });
+      frozen.add(tag, [] { return std::unique_ptr<BBase>{}; });
+    }
+    frozen.freeze();
+
+    std::vector<std::string_view> views(tags.begin(), tags.end());
+    std::vector<const char *> cstrs;
+    for (const auto & tag : tags) { cstrs.push_back(tag.c_str()); }
+
+    std::size_t i = 0;
+
+    BENCHMARK("std::map<std::string> from const char * (n=" + std::to_string(n) + ")")
+    {
+      i = (i + 7) % n;
+      return map.find(cstrs[i])->second();
+    };
+
+    BENCHMARK("Factory::create from std::string_view (n=" + std::to_string(n) + ")")
+    {
+      i = (i + 7) % n;
+      return factory.create(views[i]);
+    };
+
+    BENCHMARK("Factory::create from const char * (n=" + std::to_string(n) + ")")
+    {
+      i = (i + 7) % n;
+      return factory.create(cstrs[i]);
+    };
+
+    BENCHMARK("Frozen Factory::create from std::string_view (n=" + std::to_string(n) + ")")
+    {
+      i = (i + 7) % n;
+      return frozen.create(views[i]);
+    };
+  }
+}
+
+TEST_CASE("FactoryHotTag")
+{
+  using namespace ezconfig::literals;
+
+  BFactory factory;
+  for (const auto & tag : make_tags(100)) { factory.add(tag, [] { return std::unique_ptr<BBase>{}; }); }
+  const auto id = factory.id("!some_registered_tag_42");
+
+  BENCHMARK("Factory::create from string literal") { return factory.create("!some_registered_tag_42"); };
+
+  BENCHMARK("Factory::create from _tag literal") { return factory.create("!some_registered_tag_42"_tag); };
+
+  BENCHMARK("Factory::create from TagId") { return factory.create(id); };
+}
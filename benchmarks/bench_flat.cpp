@@ -0,0 +1,74 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/yaml_types/flat.hpp"
+#include "ezconfig/yaml_types/stl.hpp"
+
+static constexpr int kSize = 10000;
+
+static YAML::Node Table()
+{
+  std::string yaml_str;
+  // keys in "random" order
+  for (int i = 0; i < kSize; ++i) { yaml_str += std::to_string((i * 7919) % kSize) + ": " + std::to_string(i) + "\n"; }
+  return YAML::Load(yaml_str);
+}
+
+TEST_CASE("FlatDecode")
+{
+  const auto yaml = Table();
+
+  BENCHMARK("FlatMap insert per element")
+  {
+    ezconfig::FlatMap<int, int> map;
+    for (const auto & kv : yaml) {
+      map.insert({ezconfig::yaml::As<int>(kv.first), ezconfig::yaml::As<int>(kv.second)});
+    }
+    return map;
+  };
+
+  BENCHMARK("FlatMap sort once")
+  {
+    return yaml.as<ezconfig::FlatMap<int, int>>();
+  };
+
+  BENCHMARK("std::map")
+  {
+    return ezconfig::yaml::As<std::map<int, int>>(yaml);
+  };
+}
+
+TEST_CASE("FlatLookup")
+{
+  const auto yaml = Table();
+  const auto flat = yaml.as<ezconfig::FlatMap<int, int>>();
+  const auto map  = ezconfig::yaml::As<std::map<int, int>>(yaml);
+  const auto umap = yaml.as<std::unordered_map<int, int>>();
+
+  const auto lookups = [](const auto & m) {
+    long sum = 0;
+    for (int i = 0; i < kSize; ++i) { sum += m.find((i * 104729) % kSize)->second; }
+    return sum;
+  };
+
+  BENCHMARK("FlatMap")
+  {
+    return lookups(flat);
+  };
+
+  BENCHMARK("std::map")
+  {
+    return lookups(map);
+  };
+
+  BENCHMARK("std::unordered_map")
+  {
+    return lookups(umap);
+  };
+}
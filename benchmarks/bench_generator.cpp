@@ -0,0 +1,61 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/generator.hpp"
+
+struct BBase
+{
+  virtual ~BBase()       = default;
+  virtual int id() const = 0;
+};
+
+struct BDerived : public BBase
+{
+  explicit BDerived(int x) : m_x(x) {}
+  int id() const override { return m_x; }
+  int m_x;
+};
+
+TEST_CASE("GeneratorDispatch")
+{
+  static constexpr std::size_t kGenerators = 64;
+
+  // a registry worth of distinct callables, so that calls are not devirtualized
+  std::vector<std::function<int(int)>> functions;
+  std::vector<ezconfig::Generator<int(int)>> generators;
+  for (auto i = 0u; i < kGenerators; ++i) {
+    functions.emplace_back([](int x) { return x + 1; });
+    generators.emplace_back([](int x) { return x + 1; });
+  }
+
+  std::cout << "sizeof(std::function): " << sizeof(std::function<int(int)>) << std::endl;
+  std::cout << "sizeof(ezconfig::Generator): " << sizeof(ezconfig::Generator<int(int)>) << std::endl;
+
+  BENCHMARK("std::function dispatch")
+  {
+    int x = 0;
+    for (const auto & f : functions) { x = f(x); }
+    return x;
+  };
+
+  BENCHMARK("ezconfig::Generator dispatch")
+  {
+    int x = 0;
+    for (const auto & g : generators) { x = g(x); }
+    return x;
+  };
+
+  std::function<std::unique_ptr<BBase>(int)> function        = [](int x) { return std::make_unique<BDerived>(x); };
+  ezconfig::Generator<std::unique_ptr<BBase>(int)> generator = [](int x) { return std::make_unique<BDerived>(x); };
+
+  BENCHMARK("std::function create") { return function(1); };
+
+  BENCHMARK("ezconfig::Generator create") { return generator(1); };
+}
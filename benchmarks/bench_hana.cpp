@@ -0,0 +1,80 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <string>
+
+#include <boost/hana/adapt_struct.hpp>
+#include <boost/hana/at_key.hpp>
+#include <boost/hana/keys.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/yaml_types/hana.hpp"
+
+/// @brief Struct with many members.
+struct BLarge
+{
+  std::string f0;
+  std::string f1;
+  std::string f2;
+  std::string f3;
+  std::string f4;
+  std::string f5;
+  std::string f6;
+  std::string f7;
+  std::string f8;
+  std::string f9;
+  std::string f10;
+  std::string f11;
+  std::string f12;
+  std::string f13;
+  std::string f14;
+  std::string f15;
+  std::string f16;
+  std::string f17;
+  std::string f18;
+  std::string f19;
+  std::string f20;
+  std::string f21;
+  std::string f22;
+  std::string f23;
+  std::string f24;
+  std::string f25;
+  std::string f26;
+  std::string f27;
+  std::string f28;
+  std::string f29;
+  std::string f30;
+  std::string f31;
+};
+
+BOOST_HANA_ADAPT_STRUCT(
+  BLarge, f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+  f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29, f30, f31);
+
+/// @brief Decoding with one map lookup per member.
+static BLarge DecodeLookup(const YAML::Node & yaml)
+{
+  BLarge t;
+  boost::hana::for_each(boost::hana::keys(t), [&](auto key) {
+    using ValT                  = std::decay_t<decltype(boost::hana::at_key(t, key))>;
+    boost::hana::at_key(t, key) = yaml[boost::hana::to<char const *>(key)].template as<ValT>();
+  });
+  return t;
+}
+
+TEST_CASE("HanaStruct")
+{
+  std::string yaml_str;
+  for (auto i = 0u; i < 32; ++i) { yaml_str += "f" + std::to_string(i) + ": value" + std::to_string(i) + "\n"; }
+  const auto yaml = YAML::Load(yaml_str);
+
+  BENCHMARK("lookup per member")
+  {
+    return DecodeLookup(yaml);
+  };
+
+  BENCHMARK("single pass")
+  {
+    return yaml.as<BLarge>();
+  };
+}
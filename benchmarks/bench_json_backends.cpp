@@ -0,0 +1,84 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/json.hpp"
+#include "ezconfig/simdjson.hpp"
+
+struct BBase
+{
+  virtual ~BBase() = default;
+};
+
+EZ_JSON_DECLARE(BBase);
+EZ_JSON_DEFINE(BBase);
+EZ_SIMDJSON_DECLARE(BBase);
+EZ_SIMDJSON_DEFINE(BBase);
+
+struct BName : public BBase
+{
+  explicit BName(std::string && n) : name(std::move(n)) {}
+
+  std::string name;
+};
+
+struct BPoints : public BBase
+{
+  explicit BPoints(std::vector<double> && p) : points(std::move(p)) {}
+
+  std::vector<double> points;
+};
+
+struct BGroup : public BBase
+{
+  explicit BGroup(std::vector<std::unique_ptr<BBase>> && c) : children(std::move(c)) {}
+
+  std::vector<std::unique_ptr<BBase>> children;
+};
+
+EZ_JSON_REGISTER(BBase, "name", BName, std::string);
+EZ_JSON_REGISTER(BBase, "points", BPoints, std::vector<double>);
+EZ_JSON_REGISTER(BBase, "group", BGroup, std::vector<std::unique_ptr<BBase>>);
+
+EZ_SIMDJSON_REGISTER(BBase, "name", BName, std::string);
+EZ_SIMDJSON_REGISTER(BBase, "points", BPoints, std::vector<double>);
+EZ_SIMDJSON_REGISTER(BBase, "group", BGroup, std::vector<std::unique_ptr<BBase>>);
+
+/// @brief Config with n groups of a name and a few points each.
+static std::string MakeConfig(std::size_t n)
+{
+  std::string ret = "[";
+  for (auto i = 0u; i < n; ++i) {
+    ret += (i > 0 ? ", " : "");
+    ret += R"({"group": [{"name": "object_)" + std::to_string(i) + R"("}, {"points": [)";
+    for (auto j = 0u; j < 8; ++j) { ret += (j > 0 ? ", " : "") + std::to_string(0.25 * (i + j)); }
+    ret += "]}]}";
+  }
+  return ret + "]";
+}
+
+TEST_CASE("JsonBackends")
+{
+  using ConfigT = std::vector<std::unique_ptr<BBase>>;
+
+  for (const std::size_t n : {10u, 1'000u, 100'000u}) {
+    const auto config = MakeConfig(n);
+    const simdjson::padded_string padded(config);
+    simdjson::ondemand::parser parser;
+
+    BENCHMARK("nlohmann " + std::to_string(n))
+    {
+      return nlohmann::json::parse(config).get<ConfigT>();
+    };
+
+    BENCHMARK("simdjson " + std::to_string(n))
+    {
+      return ezconfig::simdjson::Get<ConfigT>(parser, padded);
+    };
+  }
+}
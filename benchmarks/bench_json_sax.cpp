@@ -0,0 +1,108 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/json.hpp"
+
+namespace {
+
+std::atomic<std::size_t> gCurrent{0};
+std::atomic<std::size_t> gPeak{0};
+
+/// @brief Size header that keeps the payload max-aligned.
+constexpr std::size_t kHeader = alignof(std::max_align_t);
+
+}  // namespace
+
+void * operator new(std::size_t size)
+{
+  auto * p = static_cast<char *>(std::malloc(size + kHeader));
+  if (p == nullptr) { throw std::bad_alloc(); }
+  *reinterpret_cast<std::size_t *>(p) = size;
+  const auto current = gCurrent.fetch_add(size, std::memory_order_relaxed) + size;
+  auto peak          = gPeak.load(std::memory_order_relaxed);
+  while (current > peak && !gPeak.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+  return p + kHeader;
+}
+
+void operator delete(void * ptr) noexcept
+{
+  if (ptr == nullptr) { return; }
+  auto * p = static_cast<char *>(ptr) - kHeader;
+  gCurrent.fetch_sub(*reinterpret_cast<std::size_t *>(p), std::memory_order_relaxed);
+  std::free(p);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept { operator delete(ptr); }
+
+struct BBase
+{
+  virtual ~BBase() = default;
+};
+
+EZ_JSON_DECLARE(BBase);
+EZ_JSON_DEFINE(BBase);
+
+struct BData : public BBase
+{
+  explicit BData(std::vector<double> && d) : data(std::move(d)) {}
+
+  std::vector<double> data;
+};
+
+EZ_JSON_REGISTER(BBase, "data", BData, std::vector<double>);
+
+static std::string MakeInput(std::size_t n)
+{
+  std::string ret = R"({"data": [)";
+  for (auto i = 0u; i < n; ++i) { ret += (i > 0 ? ", " : "") + std::to_string(0.5 * i); }
+  return ret + "]}";
+}
+
+/// @brief Peak heap usage (in excess of the usage before the call) of f().
+template<typename F>
+static std::size_t PeakBytes(F && f)
+{
+  const auto before = gCurrent.load();
+  gPeak             = before;
+  f();
+  return gPeak.load() - before;
+}
+
+TEST_CASE("JsonSaxMemory")
+{
+  for (const std::size_t n : {1'000u, 100'000u, 1'000'000u}) {
+    const auto input = MakeInput(n);
+    const auto dom   = PeakBytes([&] { return ezconfig::json::Create<BBase>(nlohmann::json::parse(input)); });
+    const auto sax   = PeakBytes([&] { return ezconfig::json::SaxCreate<BBase>(input); });
+    std::cout << n << " values (" << input.size() << " bytes): peak heap dom " << dom << " bytes, sax " << sax
+              << " bytes" << std::endl;
+    REQUIRE(sax < dom);
+  }
+}
+
+TEST_CASE("JsonSaxTime")
+{
+  for (const std::size_t n : {1'000u, 100'000u}) {
+    const auto input = MakeInput(n);
+
+    BENCHMARK("dom " + std::to_string(n))
+    {
+      return ezconfig::json::Create<BBase>(nlohmann::json::parse(input));
+    };
+
+    BENCHMARK("sax " + std::to_string(n))
+    {
+      return ezconfig::json::SaxCreate<BBase>(input);
+    };
+  }
+}
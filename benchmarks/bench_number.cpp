@@ -0,0 +1,70 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/yaml_types/decode.hpp"
+#include "ezconfig/yaml_types/eigen.hpp"
+
+static constexpr std::size_t kNumbers = 100000;
+
+/// @brief Print decoding throughput in numbers per second.
+template<typename F>
+static void PrintThroughput(const std::string & name, F && f)
+{
+  const auto t0 = std::chrono::steady_clock::now();
+  auto n        = 0u;
+  for (; n < 10; ++n) { f(); }
+  const std::chrono::duration<double> t = std::chrono::steady_clock::now() - t0;
+  std::cout << name << ": " << static_cast<double>(n * kNumbers) / t.count() / 1e6 << " M numbers/s\n";
+}
+
+TEST_CASE("NumberDouble")
+{
+  std::string yaml_str = "[";
+  for (auto i = 0u; i < kNumbers; ++i) { yaml_str += (i > 0 ? ", " : "") + std::to_string(i * 0.001 - 20.); }
+  const auto yaml = YAML::Load(yaml_str + "]");
+
+  PrintThroughput("yaml-cpp", [&] { return yaml.as<std::vector<double>>(); });
+  PrintThroughput("from_chars", [&] { return ezconfig::yaml::As<std::vector<double>>(yaml); });
+
+  BENCHMARK("yaml-cpp")
+  {
+    return yaml.as<std::vector<double>>();
+  };
+
+  BENCHMARK("from_chars")
+  {
+    return ezconfig::yaml::As<std::vector<double>>(yaml);
+  };
+
+  BENCHMARK("Eigen::VectorXd")
+  {
+    return yaml.as<Eigen::VectorXd>();
+  };
+}
+
+TEST_CASE("NumberInt")
+{
+  std::string yaml_str = "[";
+  for (auto i = 0u; i < kNumbers; ++i) { yaml_str += (i > 0 ? ", " : "") + std::to_string(static_cast<int>(i) * 7 - 1000); }
+  const auto yaml = YAML::Load(yaml_str + "]");
+
+  PrintThroughput("yaml-cpp", [&] { return yaml.as<std::vector<int>>(); });
+  PrintThroughput("from_chars", [&] { return ezconfig::yaml::As<std::vector<int>>(yaml); });
+
+  BENCHMARK("yaml-cpp")
+  {
+    return yaml.as<std::vector<int>>();
+  };
+
+  BENCHMARK("from_chars")
+  {
+    return ezconfig::yaml::As<std::vector<int>>(yaml);
+  };
+}
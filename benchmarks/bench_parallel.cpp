@@ -0,0 +1,53 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/yaml.hpp"
+
+struct BBase
+{
+  virtual ~BBase() = default;
+};
+
+EZ_YAML_DECLARE(BBase);
+EZ_YAML_DEFINE(BBase);
+
+/// @brief Simulates a constructor that loads a model: some blocking io followed by some compute.
+struct BSlow : public BBase
+{
+  explicit BSlow(int ms)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+    while (std::chrono::steady_clock::now() < end) {}
+  }
+};
+
+EZ_YAML_REGISTER(BBase, "!slow", BSlow, int);
+
+TEST_CASE("ParallelStartup")
+{
+  static constexpr std::size_t kChildren = 16;
+
+  std::string yaml_str;
+  for (auto i = 0u; i < kChildren; ++i) { yaml_str += "- !slow 5\n"; }
+  const auto yaml = YAML::Load(yaml_str);
+
+  BENCHMARK(std::to_string(kChildren) + " children sequential")
+  {
+    return yaml.as<std::vector<std::unique_ptr<BBase>>>();
+  };
+
+  for (const std::size_t threads : {1u, 2u, 4u, 8u, 16u}) {
+    ezconfig::ThreadPool pool(threads - 1);
+    BENCHMARK(std::to_string(kChildren) + " children with " + std::to_string(threads) + " threads")
+    {
+      return ezconfig::yaml::CreateParallel<BBase>(yaml, pool);
+    };
+  }
+}
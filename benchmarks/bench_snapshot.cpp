@@ -0,0 +1,78 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/yaml_snapshot.hpp"
+
+struct BBase
+{
+  virtual ~BBase() = default;
+};
+
+EZ_YAML_SNAPSHOT_DECLARE(BBase);
+EZ_YAML_SNAPSHOT_DEFINE(BBase);
+
+struct BName : public BBase
+{
+  explicit BName(std::string && n) : name(std::move(n)) {}
+
+  std::string name;
+};
+
+struct BPoints : public BBase
+{
+  explicit BPoints(std::vector<double> && p) : points(std::move(p)) {}
+
+  std::vector<double> points;
+};
+
+struct BGroup : public BBase
+{
+  explicit BGroup(std::vector<std::unique_ptr<BBase>> && c) : children(std::move(c)) {}
+
+  std::vector<std::unique_ptr<BBase>> children;
+};
+
+EZ_YAML_SNAPSHOT_REGISTER(BBase, "!name", BName, std::string);
+EZ_YAML_SNAPSHOT_REGISTER(BBase, "!points", BPoints, std::vector<double>);
+EZ_YAML_SNAPSHOT_REGISTER(BBase, "!group", BGroup, std::vector<std::unique_ptr<BBase>>);
+
+TEST_CASE("Snapshot")
+{
+  const auto dir      = std::filesystem::temp_directory_path();
+  const auto path     = dir / "ezconfig_bench_snapshot.yaml";
+  const auto snapshot = dir / "ezconfig_bench_snapshot.bin";
+
+  for (const std::size_t n : {10u, 1'000u, 10'000u}) {
+    {
+      std::ofstream out(path);
+      out << "!group\n";
+      for (auto i = 0u; i < n; ++i) {
+        out << "- !group\n  - !name object_" << i << "\n  - !points [";
+        for (auto j = 0u; j < 8; ++j) { out << (j > 0 ? ", " : "") << 0.25 * (i + j); }
+        out << "]\n";
+      }
+    }
+    std::filesystem::remove(snapshot);
+    ezconfig::yaml::LoadFileCached<BBase>(path, snapshot);
+
+    BENCHMARK("parse " + std::to_string(n))
+    {
+      return ezconfig::yaml::LoadFile<BBase>(path);
+    };
+
+    BENCHMARK("snapshot " + std::to_string(n))
+    {
+      return ezconfig::yaml::LoadFileCached<BBase>(path, snapshot);
+    };
+  }
+
+  std::filesystem::remove(path);
+  std::filesystem::remove(snapshot);
+}
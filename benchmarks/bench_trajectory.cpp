@@ -0,0 +1,69 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/yaml_types/smooth.hpp"
+
+static constexpr std::size_t kPoses = 100000;
+
+/// @brief Print decoding throughput in poses per second.
+template<typename F>
+static void PrintThroughput(const std::string & name, F && f)
+{
+  const auto t0 = std::chrono::steady_clock::now();
+  auto n        = 0u;
+  for (; n < 3; ++n) { f(); }
+  const std::chrono::duration<double> t = std::chrono::steady_clock::now() - t0;
+  std::cout << name << ": " << static_cast<double>(n * kPoses) / t.count() / 1e6 << " M poses/s\n";
+}
+
+static void BenchmarkTrajectory(const std::string & name, const YAML::Node & yaml)
+{
+  const auto per_pose = [&] {
+    std::vector<smooth::SE3d> ret;
+    for (const auto & item : yaml) { ret.push_back(item.as<smooth::SE3d>()); }
+    return ret;
+  };
+  const auto aos = [&] { return ezconfig::yaml::As<std::vector<smooth::SE3d>>(yaml); };
+  const auto soa = [&] { return yaml.as<ezconfig::SE3Trajectory<double>>(); };
+
+  PrintThroughput(name + " per pose", per_pose);
+  PrintThroughput(name + " vector", aos);
+  PrintThroughput(name + " arrays", soa);
+
+  BENCHMARK(name + " per pose")
+  {
+    return per_pose();
+  };
+
+  BENCHMARK(name + " vector")
+  {
+    return aos();
+  };
+
+  BENCHMARK(name + " arrays")
+  {
+    return soa();
+  };
+}
+
+TEST_CASE("Trajectory")
+{
+  std::string flat_str   = "[";
+  std::string nested_str = "[";
+  for (auto i = 0u; i < kPoses; ++i) {
+    const auto x = std::to_string(0.01 * i);
+    flat_str += (i > 0 ? ", " : "") + ("{x: " + x + ", y: 1.5, z: -2.25, qw: 0.5, qx: 0.5, qy: -0.5, qz: 0.5}");
+    nested_str += (i > 0 ? ", " : "")
+                + ("{translation: [" + x + ", 1.5, -2.25], orientation: {w: 0.5, x: 0.5, y: -0.5, z: 0.5}}");
+  }
+
+  BenchmarkTrajectory("flat", YAML::Load(flat_str + "]"));
+  BenchmarkTrajectory("nested", YAML::Load(nested_str + "]"));
+}
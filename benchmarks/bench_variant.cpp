@@ -0,0 +1,107 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <array>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <boost/hana/for_each.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/yaml_types/hana.hpp"
+
+template<std::size_t I>
+struct BAlt
+{
+  std::size_t value;
+};
+
+// cheap decoding, so that the benchmark measures the dispatch
+template<std::size_t I>
+struct YAML::convert<BAlt<I>>
+{
+  static bool decode(const YAML::Node & yaml, BAlt<I> & obj)
+  {
+    obj.value = yaml.Scalar().size() + I;
+    return true;
+  }
+};
+
+/// @brief Tag "!a<I>".
+template<std::size_t I>
+struct BTag
+{
+  static constexpr auto value = [] {
+    std::array<char, 8> ret{'!', 'a'};
+    auto n = 2u;
+    for (auto d = I >= 10 ? 10u : 1u; d > 0; d /= 10) { ret[n++] = static_cast<char>('0' + (I / d) % 10); }
+    return ret;
+  }();
+};
+
+template<typename Seq>
+struct BVariantImpl;
+
+template<std::size_t... I>
+struct BVariantImpl<std::index_sequence<I...>>
+{
+  using type = std::variant<BAlt<I>...>;
+};
+
+/// @brief Variant with N alternatives.
+template<std::size_t N>
+using BVariant = typename BVariantImpl<std::make_index_sequence<N>>::type;
+
+template<std::size_t... I>
+struct ezconfig::variant_hana_maps<std::variant<BAlt<I>...>>
+{
+  static constexpr auto value =
+    boost::hana::make_tuple(boost::hana::make_pair(BTag<I>::value.data(), boost::hana::type_c<BAlt<I>>)...);
+};
+
+/// @brief Decoding by comparing the tag against all alternatives.
+template<typename V>
+static V DecodeLinear(const YAML::Node & yaml)
+{
+  V ret;
+  boost::hana::for_each(ezconfig::variant_hana_maps<V>::value, [&](const auto & entry) {
+    if (boost::hana::first(entry) == yaml.Tag()) {
+      using type = std::decay_t<decltype(boost::hana::second(entry))>::type;
+      ret        = yaml.template as<type>();
+    }
+  });
+  return ret;
+}
+
+template<std::size_t N>
+static void Run()
+{
+  // sequence with all tags
+  std::string yaml_str;
+  for (auto i = 0u; i < 64; ++i) { yaml_str += "- !a" + std::to_string(i % N) + " x\n"; }
+  const auto yaml = YAML::Load(yaml_str);
+  const std::vector<YAML::Node> nodes(yaml.begin(), yaml.end());
+
+  BENCHMARK("linear " + std::to_string(N))
+  {
+    std::size_t ret = 0;
+    for (const auto & node : nodes) { ret += DecodeLinear<BVariant<N>>(node).index(); }
+    return ret;
+  };
+
+  BENCHMARK("table " + std::to_string(N))
+  {
+    std::size_t ret = 0;
+    for (const auto & node : nodes) { ret += node.as<BVariant<N>>().index(); }
+    return ret;
+  };
+}
+
+TEST_CASE("VariantDecode")
+{
+  Run<2>();
+  Run<16>();
+  Run<64>();
+}
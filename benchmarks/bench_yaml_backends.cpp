@@ -0,0 +1,82 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/ryml.hpp"
+#include "ezconfig/yaml.hpp"
+
+struct BBase
+{
+  virtual ~BBase() = default;
+};
+
+EZ_YAML_DECLARE(BBase);
+EZ_YAML_DEFINE(BBase);
+EZ_RYML_DECLARE(BBase);
+EZ_RYML_DEFINE(BBase);
+
+struct BName : public BBase
+{
+  explicit BName(std::string && n) : name(std::move(n)) {}
+
+  std::string name;
+};
+
+struct BPoints : public BBase
+{
+  explicit BPoints(std::vector<double> && p) : points(std::move(p)) {}
+
+  std::vector<double> points;
+};
+
+struct BGroup : public BBase
+{
+  explicit BGroup(std::vector<std::unique_ptr<BBase>> && c) : children(std::move(c)) {}
+
+  std::vector<std::unique_ptr<BBase>> children;
+};
+
+EZ_YAML_REGISTER(BBase, "!name", BName, std::string);
+EZ_YAML_REGISTER(BBase, "!points", BPoints, std::vector<double>);
+EZ_YAML_REGISTER(BBase, "!group", BGroup, std::vector<std::unique_ptr<BBase>>);
+
+EZ_RYML_REGISTER(BBase, "!name", BName, std::string);
+EZ_RYML_REGISTER(BBase, "!points", BPoints, std::vector<double>);
+EZ_RYML_REGISTER(BBase, "!group", BGroup, std::vector<std::unique_ptr<BBase>>);
+
+/// @brief Scene with n groups of a name and a few points each.
+static std::string MakeScene(std::size_t n)
+{
+  std::string ret;
+  for (auto i = 0u; i < n; ++i) {
+    ret += "- !group\n  - !name object_" + std::to_string(i) + "\n  - !points [";
+    for (auto j = 0u; j < 8; ++j) { ret += (j > 0 ? ", " : "") + std::to_string(0.25 * (i + j)); }
+    ret += "]\n";
+  }
+  return ret;
+}
+
+TEST_CASE("YamlBackends")
+{
+  using SceneT = std::vector<std::unique_ptr<BBase>>;
+
+  for (const std::size_t n : {10u, 1'000u, 100'000u}) {
+    const auto scene = MakeScene(n);
+
+    BENCHMARK("yaml-cpp " + std::to_string(n))
+    {
+      return YAML::Load(scene).as<SceneT>();
+    };
+
+    BENCHMARK("rapidyaml " + std::to_string(n))
+    {
+      const auto tree = ryml::parse_in_arena(ryml::to_csubstr(scene));
+      return ezconfig::ryml::Get<SceneT>(tree.crootref());
+    };
+  }
+}
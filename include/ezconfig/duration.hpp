@@ -0,0 +1,234 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file duration.hpp
+ * @brief Parsing and formatting of durations like "40ms", "1.5s" or "1h30m".
+ *
+ * Shared by the duration converters of the yaml backends.
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <ratio>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace ezconfig {
+
+namespace detail {
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+inline constexpr bool kFloatingCharconv = true;
+#else
+inline constexpr bool kFloatingCharconv = false;
+#endif
+
+/// @brief Parse a duration unit at p and advance p past it, returns nanoseconds per unit or 0 if invalid.
+constexpr std::int64_t ParseDurationUnit(const char *& p, const char * last) noexcept
+{
+  const auto next_is_s = [&] { return last - p > 1 && p[1] == 's'; };
+  switch (*p) {
+  case 'h':
+    p += 1;
+    return 3'600'000'000'000;
+  case 'm':
+    if (next_is_s()) {
+      p += 2;
+      return 1'000'000;
+    }
+    p += 1;
+    return 60'000'000'000;
+  case 's':
+    p += 1;
+    return 1'000'000'000;
+  case 'u':
+    if (!next_is_s()) { return 0; }
+    p += 2;
+    return 1'000;
+  case 'n':
+    if (!next_is_s()) { return 0; }
+    p += 2;
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+/// @brief Suffix for a duration period, or an empty string if it is not a named unit.
+template<typename Period>
+constexpr std::string_view DurationSuffix() noexcept
+{
+  if constexpr (std::is_same_v<Period, std::ratio<3600>>) {
+    return "h";
+  } else if constexpr (std::is_same_v<Period, std::ratio<60>>) {
+    return "m";
+  } else if constexpr (std::is_same_v<Period, std::ratio<1>>) {
+    return "s";
+  } else if constexpr (std::is_same_v<Period, std::milli>) {
+    return "ms";
+  } else if constexpr (std::is_same_v<Period, std::micro>) {
+    return "us";
+  } else if constexpr (std::is_same_v<Period, std::nano>) {
+    return "ns";
+  } else {
+    return "";
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Parse a duration.
+ *
+ * A duration is an optionally signed sequence of numbers with units, e.g. "40ms", "-1.5s" or
+ * "1h30m". Numbers may have a fraction, and the supported units are
+ * - h: hours
+ * - m: minutes
+ * - s: seconds
+ * - ms: milliseconds
+ * - us: microseconds
+ * - ns: nanoseconds
+ *
+ * A plain "0" is also accepted. Integer durations are truncated towards zero to the precision of
+ * the result, and are limited to the range of int64_t nanoseconds (about 292 years). Floating
+ * durations are only limited by the range of Rep.
+ *
+ * @param s string to parse.
+ * @param out parsed duration, only written on success.
+ *
+ * @return std::errc{} on success, std::errc::invalid_argument if s is not a duration, and
+ * std::errc::result_out_of_range if it does not fit in the result.
+ */
+template<typename Rep, typename Period>
+std::errc ParseDuration(std::string_view s, std::chrono::duration<Rep, Period> & out) noexcept
+{
+  using Target = std::chrono::duration<Rep, Period>;
+
+  const char * p    = s.data();
+  const char * last = s.data() + s.size();
+  const bool neg    = p != last && *p == '-';
+  if (p != last && (*p == '-' || *p == '+')) { ++p; }
+  if (p == last) { return std::errc::invalid_argument; }
+  if (last - p == 1 && *p == '0') {
+    out = Target::zero();
+    return {};
+  }
+
+  std::int64_t total = 0;  // nanoseconds for integer Rep
+  double total_f     = 0;  // Target ticks for floating Rep
+
+  while (p != last) {
+    // number [digits][.digits]
+    const char * number                = p;
+    [[maybe_unused]] std::uint64_t whole = 0;
+    if constexpr (std::is_floating_point_v<Rep>) {
+      // the whole number is parsed below, it is not limited to integer nanoseconds
+      for (; p != last && *p >= '0' && *p <= '9'; ++p) {}
+    } else if (p != last && *p >= '0' && *p <= '9') {
+      const auto [ptr, ec] = std::from_chars(p, last, whole);
+      if (ec != std::errc{}) { return ec; }
+      p = ptr;
+    }
+    [[maybe_unused]] const char * frac = p;
+    if (p != last && *p == '.') {
+      frac = ++p;
+      for (; p != last && *p >= '0' && *p <= '9'; ++p) {}
+    }
+    const char * number_end = p;
+    if (number_end == number || (number_end - number == 1 && *number == '.')) { return std::errc::invalid_argument; }
+    if (p == last) { return std::errc::invalid_argument; }
+
+    const auto unit = detail::ParseDurationUnit(p, last);
+    if (unit == 0) { return std::errc::invalid_argument; }
+
+    if constexpr (std::is_floating_point_v<Rep>) {
+      std::common_type_t<Rep, double> value{};
+      if constexpr (detail::kFloatingCharconv) {
+        const auto [ptr, ec] = std::from_chars(number, number_end, value);
+        if (ec != std::errc{}) { return std::errc::result_out_of_range; }
+        if (ptr != number_end) { return std::errc::invalid_argument; }
+      } else {
+        // the unit after the number ends the parse, so strtold does not read past the string
+        char * end = nullptr;
+        errno      = 0;
+        value      = static_cast<decltype(value)>(std::strtold(number, &end));
+        if (errno == ERANGE) { return std::errc::result_out_of_range; }
+        if (end != number_end) { return std::errc::invalid_argument; }
+      }
+      // the unit factor is computed first so that it is exact when the unit is the period
+      const auto factor =
+        (static_cast<double>(unit) * static_cast<double>(Period::den)) / (1e9 * static_cast<double>(Period::num));
+      total_f += static_cast<double>(value) * factor;
+    } else {
+      // fraction digits are added while they contribute to the nanosecond count
+      std::int64_t fraction = 0;
+      for (auto [c, scale] = std::pair{frac, unit}; c != number_end && scale > 0; ++c) {
+        scale /= 10;
+        fraction += (*c - '0') * scale;
+      }
+      constexpr auto kMax = std::numeric_limits<std::int64_t>::max();
+      if (whole > static_cast<std::uint64_t>(kMax / unit)) { return std::errc::result_out_of_range; }
+      const auto component = static_cast<std::int64_t>(whole) * unit;
+      if (component > kMax - fraction || total > kMax - component - fraction) {
+        return std::errc::result_out_of_range;
+      }
+      total += component + fraction;
+    }
+  }
+
+  if constexpr (std::is_floating_point_v<Rep>) {
+    const auto value = neg ? -total_f : total_f;
+    if (!std::isfinite(value) || std::abs(value) > static_cast<double>(std::numeric_limits<Rep>::max())) {
+      return std::errc::result_out_of_range;
+    }
+    out = Target(static_cast<Rep>(value));
+  } else {
+    const std::chrono::nanoseconds ns(neg ? -total : total);
+    const std::chrono::duration<double, Period> d = ns;
+    if (
+      d.count() > static_cast<double>(std::numeric_limits<Rep>::max())
+      || d.count() < static_cast<double>(std::numeric_limits<Rep>::lowest())) {
+      return std::errc::result_out_of_range;
+    }
+    out = std::chrono::duration_cast<Target>(ns);
+  }
+  return {};
+}
+
+/**
+ * @brief Format a duration so that ParseDuration() gives it back.
+ *
+ * Durations with a named unit (see ParseDuration()) are formatted as count and unit, e.g. "40ms".
+ * Other integer durations are converted to nanoseconds, and other floating durations to seconds.
+ */
+template<typename Rep, typename Period>
+std::string FormatDuration(const std::chrono::duration<Rep, Period> & d)
+{
+  constexpr auto kSuffix = detail::DurationSuffix<Period>();
+  if constexpr (kSuffix.empty()) {
+    if constexpr (std::is_floating_point_v<Rep>) {
+      return FormatDuration(std::chrono::duration<double>(d));
+    } else {
+      return FormatDuration(std::chrono::duration_cast<std::chrono::nanoseconds>(d));
+    }
+  } else if constexpr (std::is_floating_point_v<Rep> && !detail::kFloatingCharconv) {
+    return std::to_string(d.count()).append(kSuffix);
+  } else {
+    // shortest representation that round-trips
+    char buf[64];
+    const auto end = std::to_chars(buf, buf + sizeof(buf), d.count()).ptr;
+    return std::string(buf, end).append(kSuffix);
+  }
+}
+
+}  // namespace ezconfig
@@ -7,15 +7,44 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
-#include <map>
 #include <memory>
 #include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
 
+#include "generator.hpp"
 #include "global.hpp"
+#include "metrics.hpp"
+#include "pmr.hpp"
+#include "tag_map.hpp"
 
 namespace ezconfig {
 
+/**
+ * @brief Stable identifier of a tag in a factory, see GeneralFactory::add().
+ */
+struct TagId
+{
+  std::uint32_t index;
+
+  bool operator==(const TagId &) const = default;
+};
+
+/**
+ * @brief Types that identify a tag in a factory.
+ *
+ * - Strings are hashed at runtime.
+ * - Tag has a precomputed hash (e.g. from the _tag literal).
+ * - TagId is an index into the factory table.
+ */
+template<typename T>
+concept TagKey =
+  std::is_convertible_v<const T &, std::string_view> || std::is_same_v<T, Tag> || std::is_same_v<T, TagId>;
+
 /**
  * @brief A Factory creates objects in a class hierarchy.
  *
@@ -25,48 +54,208 @@ namespace ezconfig {
  *
  * If many = false, then the factory is (Args...) -> std::unique_ptr<Base>
  * If many = true,  then the factory is (Args...) -> std::vector<std::unique_ptr<Base>>
+ *
+ * Objects can also be created as shared pointers. A tag can be registered with a dedicated shared
+ * generator (typically using std::make_shared) that allocates the object and its control block
+ * together; if there is none the unique pointer(s) are converted.
+ *
+ * Similarly, objects can be created in a std::pmr::memory_resource. A dedicated generator receives
+ * the memory resource as an extra last argument; if there is none the object is allocated on the
+ * heap.
+ *
+ * Tags can be given as strings, as Tag with a precomputed hash, or as the TagId returned by add() or
+ * id(), which skips the hash lookup altogether.
+ *
+ * If EZ_ENABLE_METRICS is defined the factory records per-tag creation metrics, see metrics().
  */
 template<bool many, typename Base, typename... Args>
 class GeneralFactory
 {
 public:
-  using OutputT    = std::conditional_t<many, std::vector<std::unique_ptr<Base>>, std::unique_ptr<Base>>;
-  using GeneratorT = std::function<OutputT(Args...)>;
+  using OutputT          = std::conditional_t<many, std::vector<std::unique_ptr<Base>>, std::unique_ptr<Base>>;
+  using SharedOutputT    = std::conditional_t<many, std::vector<std::shared_ptr<Base>>, std::shared_ptr<Base>>;
+  using PmrOutputT       = std::conditional_t<many, std::vector<PmrUniquePtr<Base>>, PmrUniquePtr<Base>>;
+  using GeneratorT       = Generator<OutputT(Args...)>;
+  using SharedGeneratorT = Generator<SharedOutputT(Args...)>;
+  using PmrGeneratorT    = Generator<PmrOutputT(Args..., std::pmr::memory_resource *)>;
 
   /**
    * @brief Add a factory method to the factory.
    *
    * @param tag
    * @param factory
+   * @param shared_factory optional factory method for shared pointers
+   * @param pmr_factory optional factory method for memory resources
+   *
+   * @return stable id of the tag.
    */
-  void add(const std::string & tag, GeneratorT factory)
+  TagId add(
+    std::string_view tag, GeneratorT factory, SharedGeneratorT shared_factory = {}, PmrGeneratorT pmr_factory = {})
   {
-    if (m_tags.contains(tag)) { throw std::logic_error("Tag '" + tag + "' already present"); }
-    m_tags[tag] = std::move(factory);
+    const auto i =
+      m_tags.insert(tag, Generators{std::move(factory), std::move(shared_factory), std::move(pmr_factory)});
+    if (i == TagMap<Generators>::npos) {
+      if (m_tags.frozen()) { throw std::logic_error("Can not add tag '" + std::string(tag) + "' to frozen factory"); }
+      throw std::logic_error("Tag '" + std::string(tag) + "' already present");
+    }
+    return TagId{static_cast<std::uint32_t>(i)};
   }
 
+  /**
+   * @brief Get the stable id of a tag.
+   *
+   * Use the id in place of the tag to create objects in hot code paths.
+   */
+  TagId id(const TagKey auto & tag) const { return TagId{static_cast<std::uint32_t>(lookup_index(tag))}; }
+
+  /**
+   * @brief Check if the factory has a tag.
+   */
+  bool contains(std::string_view tag) const noexcept { return m_tags.contains(tag); }
+
+  /**
+   * @brief Freeze the factory.
+   *
+   * Compacts the tags into an immutable perfect hash table for faster lookups. Calling add() on a
+   * frozen factory throws.
+   *
+   * Typically called once at the start of main(), after all static registrations have run.
+   */
+  void freeze() { m_tags.freeze(); }
+
+  /**
+   * @brief Check if the factory is frozen.
+   */
+  bool frozen() const noexcept { return m_tags.frozen(); }
+
   /**
    * @brief Create an object.
+   *
+   * The tag lookup does not allocate.
+   */
+  OutputT create(const TagKey auto & tag, auto &&... args)
+  {
+    const auto & generators = lookup(tag);
+    return measure(generators, [&] { return std::invoke(generators.unique, std::forward<decltype(args)>(args)...); });
+  }
+
+  /**
+   * @brief Create an object owned by a shared pointer.
    */
-  OutputT create(const std::string & tag, auto &&... args)
+  SharedOutputT create_shared(const TagKey auto & tag, auto &&... args)
   {
-    if (auto it = m_tags.find(tag); it != m_tags.end()) {
-      return std::invoke(it->second, std::forward<decltype(args)>(args)...);
-    } else {
-      std::stringstream ss;
-      ss << "Could not find tag '" << tag << "'. ";
-      ss << "Available tags: [";
-      for (auto i = 0u; const auto & [tag_i, f] : m_tags) {
-        ss << "'" << tag_i << "'";
-        if (++i < m_tags.size()) { ss << ", "; }
+    const auto & generators = lookup(tag);
+    return measure(generators, [&]() -> SharedOutputT {
+      if (generators.shared) { return std::invoke(generators.shared, std::forward<decltype(args)>(args)...); }
+      if constexpr (many) {
+        auto objs = std::invoke(generators.unique, std::forward<decltype(args)>(args)...);
+        return SharedOutputT(std::make_move_iterator(objs.begin()), std::make_move_iterator(objs.end()));
+      } else {
+        return std::invoke(generators.unique, std::forward<decltype(args)>(args)...);
       }
-      ss << "]";
-      throw std::logic_error(ss.str());
-    }
+    });
+  }
+
+  /**
+   * @brief Create an object in a memory resource.
+   *
+   * @param tag
+   * @param resource memory resource that must outlive the object.
+   * @param args
+   */
+  PmrOutputT create_pmr(const TagKey auto & tag, std::pmr::memory_resource * resource, auto &&... args)
+  {
+    const auto & generators = lookup(tag);
+    return measure(generators, [&]() -> PmrOutputT {
+      if (generators.pmr) { return std::invoke(generators.pmr, std::forward<decltype(args)>(args)..., resource); }
+      if constexpr (many) {
+        auto objs = std::invoke(generators.unique, std::forward<decltype(args)>(args)...);
+        PmrOutputT ret;
+        ret.reserve(objs.size());
+        for (auto & obj : objs) { ret.push_back(MakePmrUnique<Base>(std::move(obj))); }
+        return ret;
+      } else {
+        return MakePmrUnique<Base>(std::invoke(generators.unique, std::forward<decltype(args)>(args)...));
+      }
+    });
   }
 
+#ifdef EZ_ENABLE_METRICS
+  /**
+   * @brief Snapshot of the creation metrics for all tags, in registration order.
+   *
+   * Only available if EZ_ENABLE_METRICS is defined.
+   *
+   * @code
+   * std::cout << ezconfig::MetricsToJson(factory.metrics()) << std::endl;
+   * @endcode
+   */
+  std::vector<TagMetricsSnapshot> metrics() const
+  {
+    std::vector<TagMetricsSnapshot> ret;
+    ret.reserve(m_tags.size());
+    for (auto i = 0u; i < m_tags.size(); ++i) { ret.push_back(m_tags[i].value.metrics->snapshot(m_tags[i].tag)); }
+    return ret;
+  }
+#endif
+
 protected:
-  std::map<std::string, GeneratorT> m_tags;
+  /// @brief Factory methods for a tag.
+  struct Generators
+  {
+    GeneratorT unique;
+    SharedGeneratorT shared;
+    PmrGeneratorT pmr;
+#ifdef EZ_ENABLE_METRICS
+    std::unique_ptr<TagMetrics> metrics{std::make_unique<TagMetrics>()};
+#endif
+  };
+
+  /// @brief Invoke a generator, and record metrics if enabled.
+  template<typename F>
+  static decltype(auto) measure([[maybe_unused]] const Generators & generators, F && f)
+  {
+#ifdef EZ_ENABLE_METRICS
+    return generators.metrics->measure(std::forward<F>(f));
+#else
+    return std::forward<F>(f)();
+#endif
+  }
+
+  const Generators & lookup(const TagKey auto & tag) const { return m_tags[lookup_index(tag)].value; }
+
+  std::size_t lookup_index(std::string_view tag) const { return lookup_index(Tag{tag, TagHash(tag)}); }
+
+  std::size_t lookup_index(Tag tag) const
+  {
+    if (const auto i = m_tags.find_index(tag.str, tag.hash); i != TagMap<Generators>::npos) { return i; }
+    throw_missing(tag.str);
+  }
+
+  std::size_t lookup_index(TagId id) const
+  {
+    if (id.index >= m_tags.size()) { throw std::logic_error("Invalid tag id " + std::to_string(id.index)); }
+    return id.index;
+  }
+
+  [[noreturn]] void throw_missing(std::string_view tag) const
+  {
+    std::vector<std::string_view> tags(m_tags.size());
+    for (auto i = 0u; i < tags.size(); ++i) { tags[i] = m_tags[i].tag; }
+    std::sort(tags.begin(), tags.end());
+
+    std::stringstream ss;
+    ss << "Could not find tag '" << tag << "'. ";
+    ss << "Available tags: [";
+    for (auto i = 0u; const auto & tag_i : tags) {
+      ss << "'" << tag_i << "'";
+      if (++i < tags.size()) { ss << ", "; }
+    }
+    ss << "]";
+    throw std::logic_error(ss.str());
+  }
+
+  TagMap<Generators> m_tags;
 };
 
 /**
@@ -109,13 +298,15 @@ concept ManyConstructible = requires { has_factory<true, Base, Args...>::value =
 #define EZ_GENERAL_FACTORY_INSTANCE(many, Base, ...) \
   EZ_GLOBAL_INSTANCE(ezconfig::GeneralFactory<many, Base __VA_OPT__(, ) __VA_ARGS__>)
 
-/// @brief Register a tag and creator method in the global factory instance.
-#define EZ_GENERAL_FACTORY_REGISTER(many, tag, creator, Base, ...)         \
-  EZ_STATIC_INVOKE(                                                        \
-    &ezconfig::GeneralFactory<many, Base __VA_OPT__(, ) __VA_ARGS__>::add, \
-    EZ_GENERAL_FACTORY_INSTANCE(many, Base, __VA_ARGS__),                  \
-    tag,                                                                   \
-    creator)
+/**
+ * @brief Register a tag and creator method in the global factory instance.
+ *
+ * The tag is added when the global factory instance is first retrieved, see EZ_GLOBAL_REGISTER.
+ */
+#define EZ_GENERAL_FACTORY_REGISTER(many, tag, creator, Base, ...)                    \
+  EZ_GLOBAL_REGISTER(                                                                 \
+    ([] { EZ_GENERAL_FACTORY_INSTANCE(many, Base, __VA_ARGS__).add(tag, creator); }), \
+    ezconfig::GeneralFactory<many, Base __VA_OPT__(, ) __VA_ARGS__>)
 
 #define EZ_FACTORY_DECLARE(Base, ...) EZ_GENERAL_FACTORY_DECLARE(false, Base, __VA_ARGS__)
 #define EZ_FACTORY_DEFINE(Base, ...) EZ_GENERAL_FACTORY_DEFINE(false, Base, __VA_ARGS__)
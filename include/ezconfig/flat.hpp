@@ -0,0 +1,561 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file flat.hpp
+ * @brief Contiguous containers for lookup tables that are read often after loading.
+ *
+ * FlatMap and FlatSet keep their elements sorted in a std::vector, which makes lookups
+ * cache-friendly at the cost of slower insertion. They are meant to be bulk-loaded, e.g. by the
+ * yaml decoders in yaml_types/flat.hpp, which sort the elements once. SmallVector stores up to N
+ * elements without allocating.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ezconfig {
+
+/**
+ * @brief Tag for constructing a FlatMap or FlatSet from elements that are sorted and unique.
+ */
+struct sorted_unique_t
+{
+  explicit sorted_unique_t() = default;
+};
+
+inline constexpr sorted_unique_t sorted_unique{};
+
+namespace detail {
+
+// clang-format off
+template<typename Compare>
+concept TransparentCompare = requires { typename Compare::is_transparent; };
+// clang-format on
+
+/**
+ * @brief Sorted vector of unique elements, shared by FlatMap and FlatSet.
+ *
+ * @tparam KeyOf function object that returns the key of an element.
+ */
+template<typename T, typename K, typename Compare, typename KeyOf>
+class SortedVector
+{
+public:
+  using key_type       = K;
+  using value_type     = T;
+  using key_compare    = Compare;
+  using container_type = std::vector<T>;
+  using size_type      = std::size_t;
+  using const_iterator = typename container_type::const_iterator;
+
+  SortedVector() = default;
+
+  /// @brief Construct from elements in any order, the first of equivalent elements is kept.
+  explicit SortedVector(container_type data, const Compare & comp = Compare())
+      : m_data(std::move(data)), m_comp(comp)
+  {
+    std::stable_sort(m_data.begin(), m_data.end(), element_less());
+    const auto equal = [this](const T & a, const T & b) { return !m_comp(KeyOf{}(a), KeyOf{}(b)); };
+    m_data.erase(std::unique(m_data.begin(), m_data.end(), equal), m_data.end());
+  }
+
+  /// @brief Construct from elements that are sorted and unique.
+  SortedVector(sorted_unique_t, container_type data, const Compare & comp = Compare())
+      : m_data(std::move(data)), m_comp(comp)
+  {}
+
+  const_iterator begin() const noexcept { return m_data.begin(); }
+  const_iterator end() const noexcept { return m_data.end(); }
+  const_iterator cbegin() const noexcept { return m_data.cbegin(); }
+  const_iterator cend() const noexcept { return m_data.cend(); }
+
+  bool empty() const noexcept { return m_data.empty(); }
+  size_type size() const noexcept { return m_data.size(); }
+  void reserve(size_type n) { m_data.reserve(n); }
+  void clear() noexcept { m_data.clear(); }
+
+  /// @brief Sorted elements.
+  const container_type & container() const noexcept { return m_data; }
+
+  /// @brief Move the sorted elements out of the container.
+  container_type extract() && { return std::move(m_data); }
+
+  key_compare key_comp() const { return m_comp; }
+
+  const_iterator lower_bound(const K & key) const { return lower_bound_impl(key); }
+
+  template<typename Q>
+    requires(TransparentCompare<Compare>)
+  const_iterator lower_bound(const Q & key) const
+  {
+    return lower_bound_impl(key);
+  }
+
+  const_iterator find(const K & key) const { return find_impl(key); }
+
+  template<typename Q>
+    requires(TransparentCompare<Compare>)
+  const_iterator find(const Q & key) const
+  {
+    return find_impl(key);
+  }
+
+  bool contains(const K & key) const { return find(key) != m_data.end(); }
+
+  template<typename Q>
+    requires(TransparentCompare<Compare>)
+  bool contains(const Q & key) const
+  {
+    return find(key) != m_data.end();
+  }
+
+  size_type count(const K & key) const { return contains(key) ? 1 : 0; }
+
+  template<typename Q>
+    requires(TransparentCompare<Compare>)
+  size_type count(const Q & key) const
+  {
+    return contains(key) ? 1 : 0;
+  }
+
+  /// @brief Erase an element by key, returns the number of erased elements.
+  size_type erase(const K & key)
+  {
+    const auto it = find(key);
+    if (it == m_data.end()) { return 0; }
+    m_data.erase(it);
+    return 1;
+  }
+
+  const_iterator erase(const_iterator it) { return m_data.erase(it); }
+
+  friend bool operator==(const SortedVector & a, const SortedVector & b) { return a.m_data == b.m_data; }
+
+protected:
+  template<typename Q>
+  const_iterator lower_bound_impl(const Q & key) const
+  {
+    // branchless binary search, which is faster than std::lower_bound for random lookups
+    if (m_data.empty()) { return m_data.end(); }
+    const T * base = m_data.data();
+    for (auto n = m_data.size(); n > 1;) {
+      const auto half = n / 2;
+      base            = m_comp(KeyOf{}(base[half]), key) ? base + half : base;
+      n -= half;
+    }
+    return m_data.begin() + (base - m_data.data()) + m_comp(KeyOf{}(*base), key);
+  }
+
+  template<typename Q>
+  const_iterator find_impl(const Q & key) const
+  {
+    const auto it = lower_bound_impl(key);
+    return it != m_data.end() && !m_comp(key, KeyOf{}(*it)) ? it : m_data.end();
+  }
+
+  auto element_less() const
+  {
+    return [this](const T & a, const T & b) { return m_comp(KeyOf{}(a), KeyOf{}(b)); };
+  }
+
+  /// @brief Insert at the sorted position unless the key exists.
+  template<typename... Args>
+  std::pair<typename container_type::iterator, bool> emplace_key(const K & key, Args &&... args)
+  {
+    const auto pos = m_data.begin() + (lower_bound(key) - m_data.cbegin());
+    if (pos != m_data.end() && !m_comp(key, KeyOf{}(*pos))) { return {pos, false}; }
+    return {m_data.emplace(pos, std::forward<Args>(args)...), true};
+  }
+
+  container_type m_data;
+  [[no_unique_address]] Compare m_comp;
+};
+
+struct PairKey
+{
+  template<typename P>
+  const auto & operator()(const P & p) const noexcept
+  {
+    return p.first;
+  }
+};
+
+struct Identity
+{
+  template<typename T>
+  const T & operator()(const T & t) const noexcept
+  {
+    return t;
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Associative container with the elements sorted in a std::vector.
+ *
+ * Iterators and references are invalidated by insertion and erasure.
+ */
+template<typename K, typename V, typename Compare = std::less<K>>
+class FlatMap : public detail::SortedVector<std::pair<K, V>, K, Compare, detail::PairKey>
+{
+  using Base = detail::SortedVector<std::pair<K, V>, K, Compare, detail::PairKey>;
+
+public:
+  using mapped_type = V;
+  using typename Base::const_iterator;
+  using typename Base::value_type;
+
+  /**
+   * @brief Mutable iterator that keeps the keys read-only.
+   *
+   * Like for std::flat_map it dereferences to a std::pair<const K &, V &> proxy, so that the
+   * sort order can not be broken by assigning to a key.
+   */
+  class iterator
+  {
+    using Underlying = typename Base::container_type::iterator;
+
+  public:
+    using iterator_concept  = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type        = std::pair<K, V>;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = std::pair<const K &, V &>;
+
+    struct pointer
+    {
+      reference ref;
+      const reference * operator->() const noexcept { return &ref; }
+    };
+
+    iterator() = default;
+
+    reference operator*() const noexcept { return {m_it->first, m_it->second}; }
+    pointer operator->() const noexcept { return {**this}; }
+    reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+    iterator & operator++() noexcept
+    {
+      ++m_it;
+      return *this;
+    }
+    iterator operator++(int) noexcept { return iterator(m_it++); }
+    iterator & operator--() noexcept
+    {
+      --m_it;
+      return *this;
+    }
+    iterator operator--(int) noexcept { return iterator(m_it--); }
+    iterator & operator+=(difference_type n) noexcept
+    {
+      m_it += n;
+      return *this;
+    }
+    iterator & operator-=(difference_type n) noexcept
+    {
+      m_it -= n;
+      return *this;
+    }
+
+    friend iterator operator+(iterator it, difference_type n) noexcept { return it += n; }
+    friend iterator operator+(difference_type n, iterator it) noexcept { return it += n; }
+    friend iterator operator-(iterator it, difference_type n) noexcept { return it -= n; }
+    friend difference_type operator-(const iterator & a, const iterator & b) noexcept { return a.m_it - b.m_it; }
+
+    friend bool operator==(const iterator &, const iterator &)  = default;
+    friend auto operator<=>(const iterator &, const iterator &) = default;
+    friend bool operator==(const iterator & a, const const_iterator & b) noexcept { return const_iterator(a) == b; }
+
+    operator const_iterator() const noexcept { return m_it; }
+
+  private:
+    friend class FlatMap;
+
+    explicit iterator(Underlying it) noexcept : m_it(it) {}
+
+    Underlying m_it{};
+  };
+
+  using Base::Base;
+
+  FlatMap(std::initializer_list<value_type> il, const Compare & comp = Compare())
+      : Base(typename Base::container_type(il), comp)
+  {}
+
+  using Base::begin;
+  using Base::end;
+  using Base::find;
+
+  iterator begin() noexcept { return iterator(this->m_data.begin()); }
+  iterator end() noexcept { return iterator(this->m_data.end()); }
+
+  iterator find(const K & key) { return to_mutable(std::as_const(*this).find(key)); }
+
+  template<typename Q>
+    requires(detail::TransparentCompare<Compare>)
+  iterator find(const Q & key)
+  {
+    return to_mutable(std::as_const(*this).find(key));
+  }
+
+  const V & at(const K & key) const { return checked_value(find(key)); }
+
+  template<typename Q>
+    requires(detail::TransparentCompare<Compare>)
+  const V & at(const Q & key) const
+  {
+    return checked_value(find(key));
+  }
+
+  V & at(const K & key) { return const_cast<V &>(std::as_const(*this).at(key)); }
+
+  template<typename Q>
+    requires(detail::TransparentCompare<Compare>)
+  V & at(const Q & key)
+  {
+    return const_cast<V &>(std::as_const(*this).at(key));
+  }
+
+  V & operator[](const K & key) { return try_emplace(key).first->second; }
+
+  template<typename... Args>
+  std::pair<iterator, bool> try_emplace(const K & key, Args &&... args)
+  {
+    const auto [it, inserted] = this->emplace_key(
+      key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+    return {iterator(it), inserted};
+  }
+
+  std::pair<iterator, bool> insert(value_type value)
+  {
+    const auto [it, inserted] = this->emplace_key(value.first, std::move(value));
+    return {iterator(it), inserted};
+  }
+
+private:
+  iterator to_mutable(const_iterator it) { return iterator(this->m_data.begin() + (it - this->m_data.cbegin())); }
+
+  const V & checked_value(const_iterator it) const
+  {
+    if (it == this->m_data.end()) { throw std::out_of_range("Key not in FlatMap"); }
+    return it->second;
+  }
+};
+
+/**
+ * @brief Set with the elements sorted in a std::vector.
+ */
+template<typename T, typename Compare = std::less<T>>
+class FlatSet : public detail::SortedVector<T, T, Compare, detail::Identity>
+{
+  using Base = detail::SortedVector<T, T, Compare, detail::Identity>;
+
+public:
+  using typename Base::const_iterator;
+  using typename Base::value_type;
+  using iterator = const_iterator;
+
+  using Base::Base;
+
+  FlatSet(std::initializer_list<T> il, const Compare & comp = Compare()) : Base(typename Base::container_type(il), comp)
+  {}
+
+  std::pair<const_iterator, bool> insert(T value)
+  {
+    const auto [it, inserted] = this->emplace_key(value, std::move(value));
+    return {it, inserted};
+  }
+};
+
+/**
+ * @brief Vector that stores up to N elements inline.
+ *
+ * Larger sizes are allocated on the heap like for std::vector.
+ */
+template<typename T, std::size_t N>
+class SmallVector
+{
+  static_assert(N > 0, "SmallVector must have inline capacity");
+
+public:
+  using value_type      = T;
+  using size_type       = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference       = T &;
+  using const_reference = const T &;
+  using iterator        = T *;
+  using const_iterator  = const T *;
+
+  SmallVector() noexcept = default;
+
+  SmallVector(size_type n, const T & value)
+  {
+    reserve(n);
+    for (size_type i = 0; i < n; ++i) { emplace_back(value); }
+  }
+
+  SmallVector(std::initializer_list<T> il)
+  {
+    reserve(il.size());
+    for (const auto & x : il) { emplace_back(x); }
+  }
+
+  SmallVector(const SmallVector & o)
+  {
+    reserve(o.size());
+    for (const auto & x : o) { emplace_back(x); }
+  }
+
+  SmallVector(SmallVector && o) noexcept(std::is_nothrow_move_constructible_v<T>) { steal(std::move(o)); }
+
+  SmallVector & operator=(const SmallVector & o)
+  {
+    if (this != &o) {
+      clear();
+      reserve(o.size());
+      for (const auto & x : o) { emplace_back(x); }
+    }
+    return *this;
+  }
+
+  SmallVector & operator=(SmallVector && o) noexcept(std::is_nothrow_move_constructible_v<T>)
+  {
+    if (this != &o) {
+      release();
+      steal(std::move(o));
+    }
+    return *this;
+  }
+
+  ~SmallVector() { release(); }
+
+  T * data() noexcept { return m_data; }
+  const T * data() const noexcept { return m_data; }
+
+  iterator begin() noexcept { return m_data; }
+  iterator end() noexcept { return m_data + m_size; }
+  const_iterator begin() const noexcept { return m_data; }
+  const_iterator end() const noexcept { return m_data + m_size; }
+
+  bool empty() const noexcept { return m_size == 0; }
+  size_type size() const noexcept { return m_size; }
+  size_type capacity() const noexcept { return m_capacity; }
+
+  /// @brief Whether the elements are stored inline.
+  bool is_inline() const noexcept { return m_data == inline_data(); }
+
+  T & operator[](size_type i) noexcept { return m_data[i]; }
+  const T & operator[](size_type i) const noexcept { return m_data[i]; }
+  T & front() noexcept { return m_data[0]; }
+  const T & front() const noexcept { return m_data[0]; }
+  T & back() noexcept { return m_data[m_size - 1]; }
+  const T & back() const noexcept { return m_data[m_size - 1]; }
+
+  void reserve(size_type n)
+  {
+    if (n > m_capacity) { reallocate(n, [](T *) { return false; }); }
+  }
+
+  template<typename... Args>
+  T & emplace_back(Args &&... args)
+  {
+    if (m_size == m_capacity) {
+      // construct the new element first since args may refer to the current elements
+      reallocate(2 * m_capacity, [&](T * p) {
+        std::construct_at(p + m_size, std::forward<Args>(args)...);
+        return true;
+      });
+    } else {
+      std::construct_at(m_data + m_size, std::forward<Args>(args)...);
+    }
+    return m_data[m_size++];
+  }
+
+  void push_back(const T & value) { emplace_back(value); }
+  void push_back(T && value) { emplace_back(std::move(value)); }
+
+  void pop_back() noexcept { std::destroy_at(m_data + --m_size); }
+
+  void clear() noexcept
+  {
+    std::destroy(m_data, m_data + m_size);
+    m_size = 0;
+  }
+
+  friend bool operator==(const SmallVector & a, const SmallVector & b)
+  {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end());
+  }
+
+private:
+  T * inline_data() noexcept { return std::launder(reinterpret_cast<T *>(m_inline)); }
+  const T * inline_data() const noexcept { return std::launder(reinterpret_cast<const T *>(m_inline)); }
+
+  /// @brief Move the elements to a new allocation, construct(p) may construct an element at p + m_size.
+  template<typename Construct>
+  void reallocate(size_type new_capacity, Construct && construct)
+  {
+    auto * p = std::allocator<T>{}.allocate(new_capacity);
+    bool constructed{false};
+    try {
+      constructed = construct(p);
+      if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+        std::uninitialized_move(m_data, m_data + m_size, p);
+      } else {
+        std::uninitialized_copy(m_data, m_data + m_size, p);
+      }
+    } catch (...) {
+      if (constructed) { std::destroy_at(p + m_size); }
+      std::allocator<T>{}.deallocate(p, new_capacity);
+      throw;
+    }
+    const auto n = m_size;
+    release();
+    m_data     = p;
+    m_size     = n;
+    m_capacity = new_capacity;
+  }
+
+  /// @brief Destroy the elements and free the heap allocation.
+  void release() noexcept
+  {
+    clear();
+    if (!is_inline()) { std::allocator<T>{}.deallocate(m_data, m_capacity); }
+    m_data     = inline_data();
+    m_capacity = N;
+  }
+
+  /// @brief Take the elements of o, which must be empty and inline.
+  void steal(SmallVector && o) noexcept(std::is_nothrow_move_constructible_v<T>)
+  {
+    if (o.is_inline()) {
+      std::uninitialized_move(o.begin(), o.end(), m_data);
+      m_size = o.m_size;
+      o.clear();
+    } else {
+      m_data     = std::exchange(o.m_data, o.inline_data());
+      m_size     = std::exchange(o.m_size, 0);
+      m_capacity = std::exchange(o.m_capacity, N);
+    }
+  }
+
+  alignas(T) std::byte m_inline[N * sizeof(T)];
+  T * m_data{inline_data()};
+  size_type m_size{0};
+  size_type m_capacity{N};
+};
+
+}  // namespace ezconfig
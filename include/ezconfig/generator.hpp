@@ -0,0 +1,171 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file generator.hpp
+ * @brief Light-weight type-erased callable for factory methods.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ezconfig {
+
+template<typename Signature>
+class Generator;
+
+/**
+ * @brief Type-erased callable R(Args...), similar to a copyable std::function.
+ *
+ * Storage depends on the callable type:
+ * - Captureless lambdas and other empty callables are not stored at all. The invoker is a plain
+ *   function pointer that default-constructs the callable, so a call is a single indirect call
+ *   with the callable body inlined.
+ * - Function pointers and callables that fit in a pointer are stored in place.
+ * - Larger callables are stored on the heap.
+ *
+ * Like std::function the callable is invoked as non-const, so mutable callables are supported.
+ * Concurrent calls are only safe if the callable does not modify its state.
+ */
+template<typename R, typename... Args>
+class Generator<R(Args...)>
+{
+  union Storage
+  {
+    void * ptr;
+    alignas(void *) std::byte buffer[sizeof(void *)];
+  };
+
+  enum class Op { Clone, Move, Destroy };
+
+  using InvokeT = R (*)(Storage &, Args...);
+  using ManageT = void (*)(Op, Storage &, Storage &);
+
+  template<typename F>
+  static constexpr bool kEmpty =
+    std::is_empty_v<F> && std::is_default_constructible_v<F> && std::is_trivially_copyable_v<F>;
+
+  template<typename F>
+  static constexpr bool kLocal =
+    sizeof(F) <= sizeof(Storage) && alignof(F) <= alignof(Storage) && std::is_nothrow_move_constructible_v<F>;
+
+public:
+  /// @brief Create an empty generator.
+  Generator() = default;
+
+  /// @brief Create a generator from a callable.
+  template<typename F>
+    requires(!std::is_same_v<std::decay_t<F>, Generator> && std::is_invocable_r_v<R, std::decay_t<F> &, Args...>)
+  Generator(F && f)
+  {
+    using T = std::decay_t<F>;
+    if constexpr (kEmpty<T>) {
+      m_invoke = [](Storage &, Args... args) -> R {
+        T t{};
+        return std::invoke(t, std::forward<Args>(args)...);
+      };
+    } else if constexpr (kLocal<T>) {
+      std::construct_at(reinterpret_cast<T *>(m_storage.buffer), std::forward<F>(f));
+      m_invoke = [](Storage & s, Args... args) -> R {
+        return std::invoke(*std::launder(reinterpret_cast<T *>(s.buffer)), std::forward<Args>(args)...);
+      };
+      if constexpr (!std::is_trivially_copyable_v<T>) {
+        m_manage = [](Op op, Storage & dst, Storage & src) {
+          auto * src_t = std::launder(reinterpret_cast<T *>(src.buffer));
+          switch (op) {
+          case Op::Clone:
+            std::construct_at(reinterpret_cast<T *>(dst.buffer), std::as_const(*src_t));
+            break;
+          case Op::Move:
+            std::construct_at(reinterpret_cast<T *>(dst.buffer), std::move(*src_t));
+            std::destroy_at(src_t);
+            break;
+          case Op::Destroy:
+            std::destroy_at(src_t);
+            break;
+          }
+        };
+      }
+    } else {
+      m_storage.ptr = new T(std::forward<F>(f));
+      m_invoke      = [](Storage & s, Args... args) -> R {
+        return std::invoke(*static_cast<T *>(s.ptr), std::forward<Args>(args)...);
+      };
+      m_manage = [](Op op, Storage & dst, Storage & src) {
+        switch (op) {
+        case Op::Clone:
+          dst.ptr = new T(*static_cast<const T *>(src.ptr));
+          break;
+        case Op::Move:
+          dst.ptr = std::exchange(src.ptr, nullptr);
+          break;
+        case Op::Destroy:
+          delete static_cast<T *>(src.ptr);
+          break;
+        }
+      };
+    }
+  }
+
+  Generator(const Generator & other) : m_invoke(other.m_invoke), m_manage(other.m_manage)
+  {
+    if (m_manage) {
+      m_manage(Op::Clone, m_storage, other.m_storage);
+    } else {
+      m_storage = other.m_storage;
+    }
+  }
+
+  Generator(Generator && other) noexcept : m_invoke(other.m_invoke), m_manage(other.m_manage)
+  {
+    if (m_manage) {
+      m_manage(Op::Move, m_storage, other.m_storage);
+    } else {
+      m_storage = other.m_storage;
+    }
+    other.m_invoke = nullptr;
+    other.m_manage = nullptr;
+  }
+
+  Generator & operator=(const Generator & other)
+  {
+    if (this != &other) { *this = Generator(other); }
+    return *this;
+  }
+
+  Generator & operator=(Generator && other) noexcept
+  {
+    if (this != &other) {
+      this->~Generator();
+      std::construct_at(this, std::move(other));
+    }
+    return *this;
+  }
+
+  ~Generator()
+  {
+    if (m_manage) { m_manage(Op::Destroy, m_storage, m_storage); }
+  }
+
+  /// @brief Invoke the callable.
+  R operator()(Args... args) const
+  {
+    if (!m_invoke) { throw std::bad_function_call(); }
+    return m_invoke(m_storage, std::forward<Args>(args)...);
+  }
+
+  /// @brief Check if the generator holds a callable.
+  explicit operator bool() const noexcept { return m_invoke != nullptr; }
+
+private:
+  mutable Storage m_storage{};
+  InvokeT m_invoke{nullptr};
+  ManageT m_manage{nullptr};
+};
+
+}  // namespace ezconfig
@@ -7,6 +7,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "macro.hpp"
+
 namespace ezconfig {
 
 /**
@@ -17,6 +25,95 @@ namespace ezconfig {
 template<typename T>
 T & gInstance();
 
+/**
+ * @brief Deferred registration with a global instance.
+ *
+ * The registration record is constant-initialized. Before main() one dynamic initializer per
+ * registration links it into an intrusive list with a compare-and-swap, which neither allocates nor
+ * touches the global instance. Registrations are invoked in order of registration when the global
+ * instance is first retrieved.
+ */
+template<typename T>
+struct Registration
+{
+  void (*invoke)();
+  Registration * next{nullptr};
+};
+
+/**
+ * @brief Head of the list of pending registrations for a global instance.
+ *
+ * Defined together with the global instance, see EZ_GLOBAL_DEFINE.
+ */
+template<typename T>
+std::atomic<Registration<T> *> & gRegistrations();
+
+/**
+ * @brief Add a registration to the pending list (lock-free and allocation-free).
+ */
+template<typename T>
+bool Register(Registration<T> & registration) noexcept
+{
+  auto & head       = gRegistrations<T>();
+  registration.next = head.load(std::memory_order_relaxed);
+  while (!head.compare_exchange_weak(
+    registration.next, &registration, std::memory_order_release, std::memory_order_relaxed)) {}
+  return true;
+}
+
+/**
+ * @brief Invoke pending registrations for a global instance.
+ *
+ * When there is nothing pending the cost is two atomic loads. Registrations are invoked under a
+ * lock, and other threads wait until they have completed. If registrations throw, the first
+ * exception is rethrown after all pending registrations have been invoked, and again on every
+ * subsequent call, so that a failed registration is not mistaken for a missing one.
+ *
+ * @note Since registrations run on first use, a single failed registration makes every later use
+ * of the global instance throw, also for registrations that succeeded.
+ */
+template<typename T>
+void RunRegistrations()
+{
+  static std::mutex mutex;
+  static std::exception_ptr error;  // guarded by mutex
+  static std::atomic<bool> failed{false};
+
+  auto & head = gRegistrations<T>();
+  if (head.load(std::memory_order_acquire) == nullptr && !failed.load(std::memory_order_acquire)) { return; }
+
+  // registrations typically retrieve the global instance themselves
+  thread_local bool running = false;
+  if (running) { return; }
+
+  std::lock_guard lock(mutex);
+  running = true;
+
+  std::vector<Registration<T> *> pending;
+  Registration<T> * done = nullptr;
+  for (auto * first = head.load(std::memory_order_acquire); first != nullptr;) {
+    // [first, done) are new, and the list is in reverse order of registration
+    pending.clear();
+    for (auto * r = first; r != done; r = r->next) { pending.push_back(r); }
+    for (auto it = pending.rbegin(); it != pending.rend(); ++it) {
+      try {
+        (*it)->invoke();
+      } catch (...) {
+        if (!error) {
+          error = std::current_exception();
+          // must be visible before the list is emptied below, which enables the fast path
+          failed.store(true, std::memory_order_release);
+        }
+      }
+    }
+    done = first;
+    if (head.compare_exchange_strong(first, nullptr, std::memory_order_acq_rel, std::memory_order_acquire)) { break; }
+  }
+
+  running = false;
+  if (error) { std::rethrow_exception(error); }
+}
+
 };  // namespace ezconfig
 
 /**
@@ -26,8 +123,10 @@ T & gInstance();
  *
  * @note Must be used outside of namespaces.
  */
-#define EZ_GLOBAL_DECLARE(...) \
-  template<>                   \
+#define EZ_GLOBAL_DECLARE(...)                                                                      \
+  template<>                                                                                        \
+  std::atomic<::ezconfig::Registration<__VA_ARGS__> *> & ::ezconfig::gRegistrations<__VA_ARGS__>(); \
+  template<>                                                                                        \
   __VA_ARGS__ & ::ezconfig::gInstance<__VA_ARGS__>()
 
 /**
@@ -37,16 +136,39 @@ T & gInstance();
  *
  * @note Must be used outside of namespaces.
  */
-#define EZ_GLOBAL_DEFINE(...)                        \
-  template<>                                         \
-  __VA_ARGS__ & ::ezconfig::gInstance<__VA_ARGS__>() \
-  {                                                  \
-    static __VA_ARGS__ global_instance{};            \
-    return global_instance;                          \
-  }                                                  \
+#define EZ_GLOBAL_DEFINE(...)                                                                      \
+  template<>                                                                                       \
+  std::atomic<::ezconfig::Registration<__VA_ARGS__> *> & ::ezconfig::gRegistrations<__VA_ARGS__>() \
+  {                                                                                                \
+    static constinit std::atomic<::ezconfig::Registration<__VA_ARGS__> *> head{nullptr};           \
+    return head;                                                                                   \
+  }                                                                                                \
+  template<>                                                                                       \
+  __VA_ARGS__ & ::ezconfig::gInstance<__VA_ARGS__>()                                               \
+  {                                                                                                \
+    static __VA_ARGS__ global_instance{};                                                          \
+    ::ezconfig::RunRegistrations<__VA_ARGS__>();                                                   \
+    return global_instance;                                                                        \
+  }                                                                                                \
   static_assert(true)
 
 /**
  * @brief Retrieve the global instance for a type.
  */
 #define EZ_GLOBAL_INSTANCE(...) ::ezconfig::gInstance<__VA_ARGS__>()
+
+/**
+ * @brief Register a function with a global instance.
+ *
+ * The function is invoked when the global instance is first retrieved. Before main() the only work
+ * is one allocation-free dynamic initializer that links the registration into a list, the global
+ * instance is not constructed.
+ *
+ * @param fn captureless callable (wrap in parentheses if it contains commas).
+ * @param ... global instance type.
+ */
+#define EZ_GLOBAL_REGISTER(fn, ...) EZ_GLOBAL_REGISTER_IMPL(EZ_ANONYMOUS_VARIABLE(ez_registration), fn, __VA_ARGS__)
+
+#define EZ_GLOBAL_REGISTER_IMPL(name, fn, ...)                     \
+  static constinit ::ezconfig::Registration<__VA_ARGS__> name{fn}; \
+  [[maybe_unused]] static const bool EZ_CONCATENATE(name, _registered) = ::ezconfig::Register(name)
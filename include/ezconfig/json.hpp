@@ -9,10 +9,19 @@
 
 #pragma once
 
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
 #include <nlohmann/json.hpp>
 
 #include "factory.hpp"
+#include "parallel.hpp"
+#include "json_binary.hpp"
 #include "json_fwd.hpp"
+#include "json_sax.hpp"
+#include "mapped_file.hpp"
 
 /**
  * @brief Define a global json factory for a base class.
@@ -26,10 +35,14 @@
  * EZ_YAML_DEFINE(MyBase);
  * @endcode
  */
-#define EZ_JSON_DEFINE(Base)                                                           \
-  EZ_FACTORY_DEFINE(Base, const nlohmann::json &);                                     \
-  template std::unique_ptr<Base> ezconfig::json::Create<Base>(const nlohmann::json &); \
-  template struct nlohmann::adl_serializer<std::shared_ptr<Base>>;                     \
+#define EZ_JSON_DEFINE(Base)                                                                 \
+  EZ_FACTORY_DEFINE(Base, const nlohmann::json &);                                           \
+  EZ_FACTORY_DEFINE(ezconfig::json::SaxObjectReader<Base>);                                  \
+  template std::unique_ptr<Base> ezconfig::json::Create<Base>(const nlohmann::json &);       \
+  template ezconfig::PmrUniquePtr<Base> ezconfig::json::Create<Base>(                        \
+    const nlohmann::json &, std::pmr::memory_resource *);                                    \
+  template std::shared_ptr<Base> ezconfig::json::CreateShared<Base>(const nlohmann::json &); \
+  template struct nlohmann::adl_serializer<std::shared_ptr<Base>>;                           \
   template struct nlohmann::adl_serializer<std::unique_ptr<Base>>
 
 /**
@@ -38,7 +51,7 @@
  * Do this in the implementation files for derived classes.
  *
  * @param Base factory base class.
- * @param tag conversion identifier (string).
+ * @param tag conversion identifier (constant non-empty string, checked at compile time).
  * @param Derived factory derived class.
  * @param Intermediate optional intermediate class.
  *
@@ -50,11 +63,19 @@
  * EZ_JSON_REGISTER(MyBase, "mytag", MyDerived, MyDerivedConfig);
  * @endcode
  */
-#define EZ_JSON_REGISTER(Base, tag, Derived, ...) \
-  EZ_STATIC_INVOKE(&ezconfig::json::Add<Base, Derived __VA_OPT__(, ) __VA_ARGS__>, tag)
+#define EZ_JSON_REGISTER(Base, tag, Derived, ...)                                 \
+  static_assert(ezconfig::json::IsValidTag(tag), "json tag must not be empty");   \
+  EZ_GLOBAL_REGISTER(                                                             \
+    ([] { ezconfig::json::Add<Base, Derived __VA_OPT__(, ) __VA_ARGS__>(tag); }), \
+    ezconfig::GeneralFactory<false, Base, const nlohmann::json &>)
 
 namespace ezconfig::json {
 
+/**
+ * @brief Check if a json tag is valid, i.e. non-empty.
+ */
+constexpr bool IsValidTag(std::string_view tag) noexcept { return !tag.empty(); }
+
 // clang-format off
 template<typename T>
 concept JsonParseable = requires(const nlohmann::json & j) {
@@ -62,6 +83,24 @@ concept JsonParseable = requires(const nlohmann::json & j) {
 };
 // clang-format on
 
+/**
+ * @brief Decode a json-parseable type.
+ *
+ * Allocator-aware types (e.g. std::pmr containers) are constructed with the memory resource before
+ * decoding, so that their allocations are made from it.
+ */
+template<typename T>
+T DecodeWithResource(const nlohmann::json & j, std::pmr::memory_resource * resource)
+{
+  if constexpr (std::uses_allocator_v<T, std::pmr::polymorphic_allocator<>>) {
+    auto obj = std::make_obj_using_allocator<T>(std::pmr::polymorphic_allocator<>(resource));
+    j.get_to(obj);
+    return obj;
+  } else {
+    return j.get<T>();
+  }
+}
+
 /**
  * @brief Add a factory method.
  *
@@ -74,15 +113,25 @@ concept JsonParseable = requires(const nlohmann::json & j) {
  * object
  *
  * to Derived, where object is yaml-converted to Intermediate.
+ *
+ * A streaming creator for SaxCreate() is added as well.
  */
 template<typename Base, typename Derived, typename Intermediate = Derived>
   requires(
     std::is_base_of_v<Base, Derived> && JsonParseable<Intermediate>
     && std::is_constructible_v<Derived, Intermediate &&>)
-void Add(const std::string & tag)
+void Add(std::string_view tag)
 {
-  auto creator = [](const nlohmann::json & json) { return std::make_unique<Derived>(json.get<Intermediate>()); };
-  EZ_FACTORY_INSTANCE(Base, const nlohmann::json &).add(tag, std::move(creator));
+  auto creator        = [](const nlohmann::json & j) { return std::make_unique<Derived>(j.get<Intermediate>()); };
+  auto shared_creator = [](const nlohmann::json & j) { return std::make_shared<Derived>(j.get<Intermediate>()); };
+  auto pmr_creator    = [](const nlohmann::json & j, std::pmr::memory_resource * resource) {
+    return MakePmrUnique<Base, Derived>(resource, DecodeWithResource<Intermediate>(j, resource));
+  };
+  EZ_FACTORY_INSTANCE(Base, const nlohmann::json &)
+    .add(tag, std::move(creator), std::move(shared_creator), std::move(pmr_creator));
+  EZ_FACTORY_INSTANCE(SaxObjectReader<Base>).add(tag, [] {
+    return std::make_unique<SaxCreator<Base, Derived, Intermediate>>();
+  });
 }
 
 template<typename Base>
@@ -94,12 +143,104 @@ std::unique_ptr<Base> Create(const nlohmann::json & json)
   return EZ_FACTORY_INSTANCE(Base, const nlohmann::json &).create(json.begin().key(), json.begin().value());
 }
 
+template<typename Base>
+PmrUniquePtr<Base> Create(const nlohmann::json & json, std::pmr::memory_resource * resource)
+{
+  if (!json.is_object() || json.size() != 1) {
+    throw std::logic_error("Expected dictionary of size 1 of format {tag: object}");
+  }
+  return EZ_FACTORY_INSTANCE(Base, const nlohmann::json &)
+    .create_pmr(json.begin().key(), resource, json.begin().value());
+}
+
+template<typename Base>
+std::shared_ptr<Base> CreateShared(const nlohmann::json & json)
+{
+  if (!json.is_object() || json.size() != 1) {
+    throw std::logic_error("Expected dictionary of size 1 of format {tag: object}");
+  }
+  return EZ_FACTORY_INSTANCE(Base, const nlohmann::json &).create_shared(json.begin().key(), json.begin().value());
+}
+
+/**
+ * @brief Create an object from a json file using the global factory.
+ *
+ * The file is memory mapped and parsed in place, see MappedFile.
+ *
+ * @param path json file of format {tag: object}
+ * @param stats optional output for file size and parse and construction times
+ *
+ * @code
+ * LoadStats stats;
+ * auto obj = json::LoadFile<MyBase>("config.json", &stats);
+ * @endcode
+ */
+template<typename Base>
+std::unique_ptr<Base> LoadFile(const std::filesystem::path & path, LoadStats * stats = nullptr)
+{
+  LoadStats s;
+  const MappedFile file(path);
+  const auto data = file.view();
+  const auto json = ::ezconfig::detail::Timed(s.parse, [&] { return nlohmann::json::parse(data.begin(), data.end()); });
+  auto ret        = ::ezconfig::detail::Timed(s.construct, [&] { return Create<Base>(json); });
+  if (stats != nullptr) {
+    s.bytes  = data.size();
+    s.mapped = file.mapped();
+    *stats   = s;
+  }
+  return ret;
+}
+
+/**
+ * @brief Create the objects in a json array in parallel.
+ *
+ * The objects are independent, so their (possibly slow) constructors can run concurrently. The
+ * output order is the array order. If creation fails the exception for the first failing element is
+ * rethrown.
+ *
+ * @param json json array of objects of format {tag: object}.
+ * @param executor executor, e.g. a ThreadPool.
+ */
+template<typename Base, Executor E>
+std::vector<std::unique_ptr<Base>> CreateParallel(const nlohmann::json & json, E && executor)
+{
+  if (!json.is_array()) { throw std::logic_error("Expected array"); }
+
+  std::vector<std::unique_ptr<Base>> ret(json.size());
+  ParallelFor(std::forward<E>(executor), json.size(), [&](std::size_t i) { ret[i] = Create<Base>(json[i]); });
+  return ret;
+}
+
+/**
+ * @brief Create the objects in a json dictionary in parallel.
+ *
+ * @see CreateParallel()
+ *
+ * @param json json dictionary from names to objects of format {tag: object}.
+ * @param executor executor, e.g. a ThreadPool.
+ */
+template<typename Base, Executor E>
+std::map<std::string, std::unique_ptr<Base>> CreateMapParallel(const nlohmann::json & json, E && executor)
+{
+  if (!json.is_object()) { throw std::logic_error("Expected dictionary"); }
+
+  std::vector<const nlohmann::json *> values;
+  values.reserve(json.size());
+  for (const auto & [key, value] : json.items()) { values.push_back(&value); }
+  std::vector<std::unique_ptr<Base>> objs(values.size());
+  ParallelFor(std::forward<E>(executor), values.size(), [&](std::size_t i) { objs[i] = Create<Base>(*values[i]); });
+
+  std::map<std::string, std::unique_ptr<Base>> ret;
+  for (auto i = 0u; const auto & [key, value] : json.items()) { ret.emplace(key, std::move(objs[i++])); }
+  return ret;
+}
+
 }  // namespace ezconfig::json
 
 template<ezconfig::json::Constructible Base>
 void nlohmann::adl_serializer<std::shared_ptr<Base>>::from_json(const json & j, std::shared_ptr<Base> & ptr)
 {
-  ptr = ::ezconfig::json::Create<Base>(j);
+  ptr = ::ezconfig::json::CreateShared<Base>(j);
 }
 
 template<ezconfig::json::Constructible Base>
@@ -0,0 +1,86 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file json_binary.hpp
+ * @brief Binary json formats.
+ *
+ * Included by json.hpp.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "json_fwd.hpp"
+
+namespace ezconfig::json {
+
+/// @brief Binary json encodings supported by nlohmann::json.
+enum class BinaryFormat {
+  Cbor,     ///< RFC 8949
+  MsgPack,  ///< MessagePack
+  Bson,     ///< BSON (the root must be an object)
+  UbJson,   ///< Universal Binary JSON
+};
+
+/**
+ * @brief Decode binary json data.
+ */
+inline nlohmann::json ParseBinary(std::span<const std::uint8_t> data, BinaryFormat format)
+{
+  switch (format) {
+  case BinaryFormat::Cbor:
+    return nlohmann::json::from_cbor(data.begin(), data.end());
+  case BinaryFormat::MsgPack:
+    return nlohmann::json::from_msgpack(data.begin(), data.end());
+  case BinaryFormat::Bson:
+    return nlohmann::json::from_bson(data.begin(), data.end());
+  case BinaryFormat::UbJson:
+    return nlohmann::json::from_ubjson(data.begin(), data.end());
+  }
+  throw std::logic_error("Invalid binary format");
+}
+
+/**
+ * @brief Encode json data in a binary format.
+ *
+ * Together with yaml::ToJson() this converts existing text configs to a compact binary form.
+ */
+inline std::vector<std::uint8_t> ToBinary(const nlohmann::json & json, BinaryFormat format)
+{
+  switch (format) {
+  case BinaryFormat::Cbor:
+    return nlohmann::json::to_cbor(json);
+  case BinaryFormat::MsgPack:
+    return nlohmann::json::to_msgpack(json);
+  case BinaryFormat::Bson:
+    return nlohmann::json::to_bson(json);
+  case BinaryFormat::UbJson:
+    return nlohmann::json::to_ubjson(json);
+  }
+  throw std::logic_error("Invalid binary format");
+}
+
+/**
+ * @brief Create an object from binary json data using the factory.
+ *
+ * The data is of format {tag: object}, see Create().
+ *
+ * @code
+ * const auto data = ReadFile("config.cbor");
+ * auto obj        = json::CreateFromBinary<MyBase>(data, json::BinaryFormat::Cbor);
+ * @endcode
+ */
+template<typename Base>
+std::unique_ptr<Base> CreateFromBinary(std::span<const std::uint8_t> data, BinaryFormat format)
+{
+  return Create<Base>(ParseBinary(data, format));
+}
+
+}  // namespace ezconfig::json
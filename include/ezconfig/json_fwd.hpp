@@ -33,6 +33,36 @@ concept Constructible = ::ezconfig::Constructible<T, const nlohmann::json &>;
 template<typename Base>
 std::unique_ptr<Base> Create(const nlohmann::json & j);
 
+/**
+ * @brief Create an object in a memory resource using the factory.
+ *
+ * The object is allocated from the memory resource. Allocator-aware objects (and intermediate
+ * types) are constructed with the memory resource, so that e.g. std::pmr container members are
+ * allocated from it as well.
+ *
+ * @tparam Base factory base class
+ *
+ * @param j json data
+ * @param resource memory resource (must outlive the object)
+ */
+template<typename Base>
+PmrUniquePtr<Base> Create(const nlohmann::json & j, std::pmr::memory_resource * resource);
+
+/**
+ * @brief Create a shared object using the factory.
+ *
+ * The object and the shared pointer control block are allocated together.
+ *
+ * @tparam Base factory base class
+ *
+ * @param j json data
+ */
+template<typename Base>
+std::shared_ptr<Base> CreateShared(const nlohmann::json & j);
+
+template<typename Base>
+class SaxObjectReader;
+
 }  // namespace ezconfig::json
 
 /**
@@ -47,10 +77,12 @@ std::unique_ptr<Base> Create(const nlohmann::json & j);
  * EZ_JSON_DECLARE(MyBase);
  * @endcode
  */
-#define EZ_JSON_DECLARE(Base) EZ_FACTORY_DECLARE(Base, const nlohmann::json &)
+#define EZ_JSON_DECLARE(Base)                       \
+  EZ_FACTORY_DECLARE(Base, const nlohmann::json &); \
+  EZ_FACTORY_DECLARE(ezconfig::json::SaxObjectReader<Base>)
 
 /**
- * @brief Converter json -> std::shared_ptr<Base> using json::Create().
+ * @brief Converter json -> std::shared_ptr<Base> using json::CreateShared().
  */
 template<ezconfig::json::Constructible Base>
 struct nlohmann::adl_serializer<std::shared_ptr<Base>>
@@ -0,0 +1,525 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file json_sax.hpp
+ * @brief Streaming json factory on top of the nlohmann SAX interface.
+ *
+ * Included by json.hpp.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "factory.hpp"
+#include "json_fwd.hpp"
+
+namespace ezconfig::json {
+
+/// @brief SAX event.
+struct SaxEvent
+{
+  enum class Type {
+    Null,
+    Boolean,
+    Integer,
+    Unsigned,
+    Float,
+    String,
+    StartObject,
+    Key,
+    EndObject,
+    StartArray,
+    EndArray,
+  };
+
+  Type type;
+  bool boolean{false};
+  std::int64_t integer{0};
+  std::uint64_t unsigned_integer{0};
+  double floating{0};
+
+  /// @brief Value for String and Key events (may be moved from).
+  std::string * string{nullptr};
+};
+
+class SaxStack;
+
+/**
+ * @brief Consumer of the SAX events for a single json value.
+ */
+class SaxNode
+{
+public:
+  enum class Status {
+    Continue,  ///< Event consumed, the value is not complete.
+    Done,      ///< Event consumed, the value is complete.
+    Forward,   ///< A child was pushed onto the stack that should receive the event.
+  };
+
+  virtual ~SaxNode() = default;
+
+  /// @brief Handle an event.
+  virtual Status on_event(SaxEvent & event, SaxStack & stack) = 0;
+
+  /// @brief Called when a child that this node pushed onto the stack is complete.
+  virtual Status on_child(SaxNode &, SaxStack &) { return Status::Continue; }
+};
+
+/**
+ * @brief Stack of SAX nodes where the top node receives the events.
+ */
+class SaxStack
+{
+public:
+  /// @brief Push a node.
+  void push(std::unique_ptr<SaxNode> node) { m_nodes.push_back(std::move(node)); }
+
+  /// @brief Dispatch an event to the top node.
+  void dispatch(SaxEvent & event)
+  {
+    if (m_nodes.empty()) { throw std::logic_error("Unexpected json value after end of document"); }
+
+    auto status = m_nodes.back()->on_event(event, *this);
+    while (status == SaxNode::Status::Forward) { status = m_nodes.back()->on_event(event, *this); }
+    while (status == SaxNode::Status::Done) {
+      auto done = std::move(m_nodes.back());
+      m_nodes.pop_back();
+      if (m_nodes.empty()) {
+        m_result = std::move(done);
+        return;
+      }
+      status = m_nodes.back()->on_child(*done, *this);
+    }
+  }
+
+  /// @brief Completed root node, or nullptr if the document is not complete.
+  SaxNode * result() const noexcept { return m_result.get(); }
+
+private:
+  std::vector<std::unique_ptr<SaxNode>> m_nodes;
+  std::unique_ptr<SaxNode> m_result;
+};
+
+/**
+ * @brief Streaming reader for a type.
+ *
+ * A reader is a SaxNode with a member T take() that is called once the value is complete.
+ *
+ * The primary template collects the events into a json value and converts it with get<T>(), i.e.
+ * it only avoids materializing the rest of the document. Specialize to stream a type directly from
+ * the events.
+ */
+template<typename T>
+class SaxReader : public SaxNode
+{
+public:
+  Status on_event(SaxEvent & event, SaxStack &) override
+  {
+    using E = SaxEvent::Type;
+    switch (event.type) {
+    case E::Null:
+      return insert(nullptr);
+    case E::Boolean:
+      return insert(event.boolean);
+    case E::Integer:
+      return insert(event.integer);
+    case E::Unsigned:
+      return insert(event.unsigned_integer);
+    case E::Float:
+      return insert(event.floating);
+    case E::String:
+      return insert(std::move(*event.string));
+    case E::Key:
+      m_key = std::move(*event.string);
+      return Status::Continue;
+    case E::StartObject:
+      insert(nlohmann::json::object());
+      return Status::Continue;
+    case E::StartArray:
+      insert(nlohmann::json::array());
+      return Status::Continue;
+    case E::EndObject:
+    case E::EndArray:
+      m_stack.pop_back();
+      return m_stack.empty() ? Status::Done : Status::Continue;
+    }
+    return Status::Continue;
+  }
+
+  T take()
+  {
+    if constexpr (std::is_same_v<T, nlohmann::json>) {
+      return std::move(m_root);
+    } else {
+      return m_root.get<T>();
+    }
+  }
+
+private:
+  /// @brief Insert a value, and descend into it if it is a container.
+  Status insert(nlohmann::json && value)
+  {
+    const bool container = value.is_structured();
+    nlohmann::json * inserted;
+    if (m_stack.empty()) {
+      m_root   = std::move(value);
+      inserted = &m_root;
+    } else if (m_stack.back()->is_array()) {
+      m_stack.back()->push_back(std::move(value));
+      inserted = &m_stack.back()->back();
+    } else {
+      inserted = &((*m_stack.back())[m_key] = std::move(value));
+    }
+    if (container) { m_stack.push_back(inserted); }
+    return m_stack.empty() ? Status::Done : Status::Continue;
+  }
+
+  nlohmann::json m_root;
+  std::vector<nlohmann::json *> m_stack;
+  std::string m_key;
+};
+
+namespace detail {
+
+// clang-format off
+template<typename T>
+concept SaxScalar = std::is_arithmetic_v<T> || std::is_same_v<T, std::string>;
+// clang-format on
+
+inline const char * SaxTypeName(SaxEvent::Type type)
+{
+  using E = SaxEvent::Type;
+  switch (type) {
+  case E::Null:
+    return "null";
+  case E::Boolean:
+    return "boolean";
+  case E::Integer:
+  case E::Unsigned:
+  case E::Float:
+    return "number";
+  case E::String:
+    return "string";
+  case E::StartObject:
+  case E::Key:
+  case E::EndObject:
+    return "object";
+  case E::StartArray:
+  case E::EndArray:
+    return "array";
+  }
+  return "unknown";
+}
+
+/// @brief Read a scalar from an event, with the same conversions as get<T>().
+template<SaxScalar T>
+T SaxRead(SaxEvent & event)
+{
+  using E = SaxEvent::Type;
+  if constexpr (std::is_same_v<T, bool>) {
+    if (event.type == E::Boolean) { return event.boolean; }
+    throw std::logic_error(std::string("type must be boolean, but is ") + SaxTypeName(event.type));
+  } else if constexpr (std::is_arithmetic_v<T>) {
+    switch (event.type) {
+    case E::Integer:
+      return static_cast<T>(event.integer);
+    case E::Unsigned:
+      return static_cast<T>(event.unsigned_integer);
+    case E::Float:
+      return static_cast<T>(event.floating);
+    case E::Boolean:
+      return static_cast<T>(event.boolean);
+    default:
+      throw std::logic_error(std::string("type must be number, but is ") + SaxTypeName(event.type));
+    }
+  } else {
+    if (event.type == E::String) { return std::move(*event.string); }
+    throw std::logic_error(std::string("type must be string, but is ") + SaxTypeName(event.type));
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Streaming reader for arithmetic types and strings.
+ */
+template<detail::SaxScalar T>
+class SaxReader<T> : public SaxNode
+{
+public:
+  Status on_event(SaxEvent & event, SaxStack &) override
+  {
+    m_value = detail::SaxRead<T>(event);
+    return Status::Done;
+  }
+
+  T take() { return std::move(m_value); }
+
+private:
+  T m_value{};
+};
+
+/**
+ * @brief Streaming reader for vectors.
+ *
+ * Scalar elements are read in place, without a node per element.
+ */
+template<typename T, typename A>
+class SaxReader<std::vector<T, A>> : public SaxNode
+{
+public:
+  Status on_event(SaxEvent & event, SaxStack & stack) override
+  {
+    using E = SaxEvent::Type;
+    if (!m_started) {
+      if (event.type != E::StartArray) {
+        throw std::logic_error(std::string("type must be array, but is ") + detail::SaxTypeName(event.type));
+      }
+      m_started = true;
+      return Status::Continue;
+    }
+    if (event.type == E::EndArray) { return Status::Done; }
+    if constexpr (detail::SaxScalar<T>) {
+      m_value.push_back(detail::SaxRead<T>(event));
+      return Status::Continue;
+    } else {
+      stack.push(std::make_unique<SaxReader<T>>());
+      return Status::Forward;
+    }
+  }
+
+  Status on_child(SaxNode & child, SaxStack &) override
+  {
+    m_value.push_back(static_cast<SaxReader<T> &>(child).take());
+    return Status::Continue;
+  }
+
+  std::vector<T, A> take() { return std::move(m_value); }
+
+private:
+  bool m_started{false};
+  std::vector<T, A> m_value;
+};
+
+/**
+ * @brief Streaming creator of an object in a class hierarchy.
+ *
+ * Readers are created by a global factory per base class, and are registered by json::Add().
+ */
+template<typename Base>
+class SaxObjectReader : public SaxNode
+{
+public:
+  virtual std::unique_ptr<Base> take() = 0;
+};
+
+/**
+ * @brief Streaming creator of Derived from Intermediate.
+ */
+template<typename Base, typename Derived, typename Intermediate>
+class SaxCreator : public SaxObjectReader<Base>
+{
+  using Status = SaxNode::Status;
+
+public:
+  Status on_event(SaxEvent &, SaxStack & stack) override
+  {
+    stack.push(std::make_unique<SaxReader<Intermediate>>());
+    return Status::Forward;
+  }
+
+  Status on_child(SaxNode & child, SaxStack &) override
+  {
+    m_obj = std::make_unique<Derived>(static_cast<SaxReader<Intermediate> &>(child).take());
+    return Status::Done;
+  }
+
+  std::unique_ptr<Base> take() override { return std::move(m_obj); }
+
+private:
+  std::unique_ptr<Base> m_obj;
+};
+
+/**
+ * @brief Creator for tags that only have a json factory method, e.g. registered with EZ_FACTORY_REGISTER.
+ *
+ * The object is collected into a json value which is passed to the factory method.
+ */
+template<typename Base>
+class SaxDomCreator : public SaxObjectReader<Base>
+{
+  using Status = SaxNode::Status;
+
+public:
+  explicit SaxDomCreator(std::string tag) : m_tag(std::move(tag)) {}
+
+  Status on_event(SaxEvent &, SaxStack & stack) override
+  {
+    stack.push(std::make_unique<SaxReader<nlohmann::json>>());
+    return Status::Forward;
+  }
+
+  Status on_child(SaxNode & child, SaxStack &) override
+  {
+    const auto json = static_cast<SaxReader<nlohmann::json> &>(child).take();
+    m_obj           = EZ_FACTORY_INSTANCE(Base, const nlohmann::json &).create(m_tag, json);
+    return Status::Done;
+  }
+
+  std::unique_ptr<Base> take() override { return std::move(m_obj); }
+
+private:
+  std::string m_tag;
+  std::unique_ptr<Base> m_obj;
+};
+
+/**
+ * @brief Streaming reader for objects of format {tag: object}.
+ *
+ * The creator for the tag is selected as soon as the key is read.
+ */
+template<Constructible Base>
+class SaxReader<std::unique_ptr<Base>> : public SaxNode
+{
+public:
+  Status on_event(SaxEvent & event, SaxStack & stack) override
+  {
+    using E = SaxEvent::Type;
+    switch (m_state) {
+    case State::Start:
+      if (event.type != E::StartObject) { break; }
+      m_state = State::Key;
+      return Status::Continue;
+    case State::Key: {
+      if (event.type != E::Key) { break; }
+      // streaming creators are added by the json factory registrations, which run on first use
+      const auto & json_factory = EZ_FACTORY_INSTANCE(Base, const nlohmann::json &);
+      auto & sax_factory        = EZ_FACTORY_INSTANCE(SaxObjectReader<Base>);
+      if (sax_factory.contains(*event.string)) {
+        stack.push(sax_factory.create(*event.string));
+      } else {
+        // throws early if the tag does not exist
+        json_factory.id(*event.string);
+        stack.push(std::make_unique<SaxDomCreator<Base>>(std::move(*event.string)));
+      }
+      m_state = State::Value;
+      return Status::Continue;
+    }
+    case State::Value:
+      break;
+    case State::End:
+      if (event.type != E::EndObject) { break; }
+      return Status::Done;
+    }
+    throw std::logic_error("Expected dictionary of size 1 of format {tag: object}");
+  }
+
+  Status on_child(SaxNode & child, SaxStack &) override
+  {
+    m_obj   = static_cast<SaxObjectReader<Base> &>(child).take();
+    m_state = State::End;
+    return Status::Continue;
+  }
+
+  std::unique_ptr<Base> take() { return std::move(m_obj); }
+
+private:
+  enum class State { Start, Key, Value, End };
+
+  State m_state{State::Start};
+  std::unique_ptr<Base> m_obj;
+};
+
+/**
+ * @brief Handler for nlohmann::json::sax_parse() that feeds a SaxStack.
+ */
+class SaxHandler
+{
+public:
+  explicit SaxHandler(std::unique_ptr<SaxNode> root) { m_stack.push(std::move(root)); }
+
+  bool null() { return dispatch({.type = SaxEvent::Type::Null}); }
+  bool boolean(bool val) { return dispatch({.type = SaxEvent::Type::Boolean, .boolean = val}); }
+  bool number_integer(std::int64_t val) { return dispatch({.type = SaxEvent::Type::Integer, .integer = val}); }
+  bool number_unsigned(std::uint64_t val)
+  {
+    return dispatch({.type = SaxEvent::Type::Unsigned, .unsigned_integer = val});
+  }
+  bool number_float(double val, const std::string &)
+  {
+    return dispatch({.type = SaxEvent::Type::Float, .floating = val});
+  }
+  bool string(std::string & val) { return dispatch({.type = SaxEvent::Type::String, .string = &val}); }
+  bool binary(nlohmann::json::binary_t &) { throw std::logic_error("Binary values are not supported"); }
+  bool start_object(std::size_t) { return dispatch({.type = SaxEvent::Type::StartObject}); }
+  bool key(std::string & val) { return dispatch({.type = SaxEvent::Type::Key, .string = &val}); }
+  bool end_object() { return dispatch({.type = SaxEvent::Type::EndObject}); }
+  bool start_array(std::size_t) { return dispatch({.type = SaxEvent::Type::StartArray}); }
+  bool end_array() { return dispatch({.type = SaxEvent::Type::EndArray}); }
+
+  template<typename Exception>
+  bool parse_error(std::size_t, const std::string &, const Exception & ex)
+  {
+    throw ex;
+  }
+
+  /// @brief Completed root node.
+  SaxNode & result() const
+  {
+    if (m_stack.result() == nullptr) { throw std::logic_error("Incomplete json document"); }
+    return *m_stack.result();
+  }
+
+private:
+  bool dispatch(SaxEvent && event)
+  {
+    m_stack.dispatch(event);
+    return true;
+  }
+
+  SaxStack m_stack;
+};
+
+/**
+ * @brief Read a value from json input without building a DOM.
+ *
+ * @param input anything accepted by nlohmann::json::sax_parse(), e.g. a string or a stream.
+ */
+template<typename T, typename InputType>
+T SaxGet(InputType && input)
+{
+  SaxHandler handler(std::make_unique<SaxReader<T>>());
+  nlohmann::json::sax_parse(std::forward<InputType>(input), &handler);
+  return static_cast<SaxReader<T> &>(handler.result()).take();
+}
+
+/**
+ * @brief Create an object from json input without building a DOM.
+ *
+ * The input is of the form {tag: object}, and the object is decoded directly from the parser events
+ * into Intermediate. The same conversions as for Create() apply, and types that have no streaming
+ * reader are collected into a json value for just that type (see SaxReader).
+ *
+ * @param input anything accepted by nlohmann::json::sax_parse(), e.g. a string or a stream.
+ *
+ * @code
+ * std::ifstream file("config.json");
+ * auto obj = json::SaxCreate<MyBase>(file);
+ * @endcode
+ */
+template<typename Base, typename InputType>
+std::unique_ptr<Base> SaxCreate(InputType && input)
+{
+  return SaxGet<std::unique_ptr<Base>>(std::forward<InputType>(input));
+}
+
+}  // namespace ezconfig::json
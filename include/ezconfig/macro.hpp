@@ -7,5 +7,12 @@
 #define EZ_CONCATENATE_IMPL(s1, s2) s1##s2
 #define EZ_CONCATENATE(s1, s2) EZ_CONCATENATE_IMPL(s1, s2)
 #define EZ_ANONYMOUS_VARIABLE(str) EZ_CONCATENATE(str, __COUNTER__)
+
+/**
+ * @brief Invoke a callable during static initialization.
+ *
+ * Eager alternative to EZ_GLOBAL_REGISTER for work that must happen before main(), e.g. registration
+ * with a global instance that must report errors at startup.
+ */
 #define EZ_STATIC_INVOKE(...) \
   static bool EZ_ANONYMOUS_VARIABLE(invoked) = [] { return (std::invoke(__VA_ARGS__), true); }()
@@ -0,0 +1,149 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file mapped_file.hpp
+ * @brief Read-only memory mapped files.
+ *
+ * Used by the LoadFile() functions of the backends to parse config files without first copying
+ * them into a string.
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define EZ_HAS_MMAP 1
+#endif
+
+namespace ezconfig {
+
+/**
+ * @brief Statistics from loading a config file.
+ */
+struct LoadStats
+{
+  /// @brief File size.
+  std::size_t bytes{0};
+
+  /// @brief Whether the file was memory mapped (otherwise it was read into a buffer).
+  bool mapped{false};
+
+  /// @brief Whether objects were created from a snapshot instead of the file, see yaml::LoadFileCached().
+  bool snapshot{false};
+
+  /// @brief Time to parse the file.
+  std::chrono::nanoseconds parse{0};
+
+  /// @brief Time to create objects from the parsed data.
+  std::chrono::nanoseconds construct{0};
+};
+
+/**
+ * @brief Read-only view of a file.
+ *
+ * The file is memory mapped if the platform supports it. Otherwise, or if mapping fails (e.g. for
+ * empty files or pipes), the file is read into a buffer.
+ */
+class MappedFile
+{
+public:
+  /**
+   * @brief Open a file.
+   *
+   * @throws std::system_error if the file can not be opened.
+   */
+  explicit MappedFile(const std::filesystem::path & path)
+  {
+#ifdef EZ_HAS_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) { throw std::system_error(errno, std::generic_category(), "Could not open '" + path.string() + "'"); }
+
+    struct stat st{};
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+      const auto size = static_cast<std::size_t>(st.st_size);
+      if (void * data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0); data != MAP_FAILED) {
+        ::madvise(data, size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char *>(data);
+        m_size = size;
+      }
+    }
+    ::close(fd);
+    if (m_data != nullptr) { return; }
+#endif
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) { throw std::system_error(errno, std::generic_category(), "Could not open '" + path.string() + "'"); }
+    m_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+
+  MappedFile(const MappedFile &)             = delete;
+  MappedFile & operator=(const MappedFile &) = delete;
+
+  ~MappedFile()
+  {
+#ifdef EZ_HAS_MMAP
+    if (m_data != nullptr) { ::munmap(const_cast<char *>(m_data), m_size); }
+#endif
+  }
+
+  /// @brief File contents.
+  std::string_view view() const noexcept { return m_data != nullptr ? std::string_view(m_data, m_size) : m_buffer; }
+
+  /// @brief Whether the file is memory mapped.
+  bool mapped() const noexcept { return m_data != nullptr; }
+
+private:
+  const char * m_data{nullptr};
+  std::size_t m_size{0};
+  std::string m_buffer;
+};
+
+/**
+ * @brief Input stream buffer over a character range that is not copied.
+ *
+ * For parsers that only read from streams.
+ */
+class ViewStreambuf : public std::streambuf
+{
+public:
+  explicit ViewStreambuf(std::string_view data)
+  {
+    // the get area is never written to
+    auto * begin = const_cast<char *>(data.data());
+    setg(begin, begin, begin + data.size());
+  }
+};
+
+namespace detail {
+
+/// @brief Invoke f and add the elapsed time to t.
+template<typename F>
+decltype(auto) Timed(std::chrono::nanoseconds & t, F && f)
+{
+  struct Timer
+  {
+    std::chrono::nanoseconds & t;
+    std::chrono::steady_clock::time_point t0{std::chrono::steady_clock::now()};
+    ~Timer() { t += std::chrono::steady_clock::now() - t0; }
+  } timer{t};
+  return std::forward<F>(f)();
+}
+
+}  // namespace detail
+
+}  // namespace ezconfig
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <array>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <string_view>
 #include <type_traits>
 
+#include "tag_map.hpp"
+
 namespace ezconfig {
 
 template<typename _Tp, typename... _Types>
@@ -20,4 +26,66 @@ constexpr std::size_t index_in_typepack()
   return n;
 }
 
+/**
+ * @brief Compile-time hash table of N strings.
+ *
+ * The strings are placed in an open-addressing table with less than half of the slots occupied.
+ * When constructed the table searches for a hash seed without collisions, which for small tables
+ * typically exists, so that a lookup is one hash, one slot read, and one string comparison. Larger
+ * tables fall back to linear probing.
+ */
+template<std::size_t N>
+class StaticStringTable
+{
+public:
+  constexpr explicit StaticStringTable(const std::array<std::string_view, N> & keys) : m_keys(keys)
+  {
+    for (m_seed = 0; m_seed < 64; ++m_seed) {
+      if (place()) { return; }
+    }
+    place();  // with collisions, resolved by linear probing
+  }
+
+  /// @brief Number of strings.
+  static constexpr std::size_t size() noexcept { return N; }
+
+  /// @brief String with index i.
+  constexpr std::string_view operator[](std::size_t i) const noexcept { return m_keys[i]; }
+
+  /// @brief Index of a string, or N if it is not in the table.
+  constexpr std::size_t find(std::string_view key) const noexcept
+  {
+    for (auto s = slot(TagHash(key)); m_slots[s] != 0; s = (s + 1) % m_slots.size()) {
+      if (m_keys[m_slots[s] - 1] == key) { return m_slots[s] - 1; }
+    }
+    return N;
+  }
+
+private:
+  static constexpr std::size_t kBits = std::bit_width(2 * N + 1);
+
+  constexpr std::size_t slot(std::uint64_t hash) const noexcept
+  {
+    const auto h = (hash ^ (m_seed * 0x9e3779b97f4a7c15ull)) * 0xff51afd7ed558ccdull;
+    return static_cast<std::size_t>(h >> (64 - kBits));
+  }
+
+  /// @brief Place the strings, returns false if there was a collision.
+  constexpr bool place() noexcept
+  {
+    m_slots        = {};
+    bool collision = false;
+    for (auto i = 0u; i < N; ++i) {
+      auto s = slot(TagHash(m_keys[i]));
+      for (; m_slots[s] != 0; s = (s + 1) % m_slots.size()) { collision = true; }
+      m_slots[s] = i + 1;
+    }
+    return !collision;
+  }
+
+  std::array<std::string_view, N> m_keys;
+  std::array<std::size_t, (std::size_t{1} << kBits)> m_slots{};
+  std::uint64_t m_seed{0};
+};
+
 }  // namespace ezconfig
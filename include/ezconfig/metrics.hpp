@@ -0,0 +1,202 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file metrics.hpp
+ * @brief Per-tag creation metrics.
+ *
+ * Factories record metrics if EZ_ENABLE_METRICS is defined, otherwise the instrumentation is
+ * compiled out. The macro must have the same value in all translation units (e.g. set through the
+ * ENABLE_METRICS CMake option).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ezconfig {
+
+/// @brief Snapshot of the metrics for a tag.
+struct TagMetricsSnapshot
+{
+  /// @brief Tag.
+  std::string tag;
+
+  /// @brief Number of calls (including failed calls).
+  std::uint64_t count{0};
+
+  /// @brief Number of calls that threw.
+  std::uint64_t failures{0};
+
+  /// @brief Cumulative construction time.
+  std::chrono::nanoseconds total{0};
+
+  /// @brief Approximate median construction time.
+  std::chrono::nanoseconds p50{0};
+
+  /// @brief Approximate 99th percentile construction time.
+  std::chrono::nanoseconds p99{0};
+
+  /// @brief Maximal construction time.
+  std::chrono::nanoseconds max{0};
+};
+
+/**
+ * @brief Lock-free construction metrics for a tag.
+ *
+ * Each thread records into one of a few cache-line aligned shards with relaxed atomic increments,
+ * and the shards are merged when a snapshot is taken. Latencies are binned in a log-linear
+ * histogram with four bins per power of two, so percentiles are accurate to within about 12%.
+ *
+ * Times are inclusive, i.e. the time to create an object includes the time to create its children.
+ */
+class TagMetrics
+{
+public:
+  /// @brief Run f() and record its duration, and whether it threw.
+  template<typename F>
+  decltype(auto) measure(F && f)
+  {
+    const auto t0 = std::chrono::steady_clock::now();
+    try {
+      decltype(auto) ret = std::forward<F>(f)();
+      record(std::chrono::steady_clock::now() - t0, false);
+      return ret;
+    } catch (...) {
+      record(std::chrono::steady_clock::now() - t0, true);
+      throw;
+    }
+  }
+
+  /// @brief Record a call.
+  void record(std::chrono::nanoseconds duration, bool failed) noexcept
+  {
+    auto & shard  = m_shards[this_thread_shard()];
+    const auto ns = static_cast<std::uint64_t>(std::max<std::int64_t>(duration.count(), 0));
+    auto max      = shard.max_ns.load(std::memory_order_relaxed);
+    shard.buckets[bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+    shard.total_ns.fetch_add(ns, std::memory_order_relaxed);
+    if (failed) { shard.failures.fetch_add(1, std::memory_order_relaxed); }
+    while (ns > max && !shard.max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {}
+  }
+
+  /// @brief Merge the shards into a snapshot.
+  TagMetricsSnapshot snapshot(std::string tag) const
+  {
+    TagMetricsSnapshot ret{.tag = std::move(tag)};
+    std::array<std::uint64_t, kBuckets> buckets{};
+    std::uint64_t total = 0, max = 0;
+    for (const auto & shard : m_shards) {
+      for (auto b = 0u; b < kBuckets; ++b) {
+        const auto n = shard.buckets[b].load(std::memory_order_relaxed);
+        buckets[b] += n;
+        ret.count += n;
+      }
+      ret.failures += shard.failures.load(std::memory_order_relaxed);
+      total += shard.total_ns.load(std::memory_order_relaxed);
+      max = std::max(max, shard.max_ns.load(std::memory_order_relaxed));
+    }
+    ret.total = std::chrono::nanoseconds(total);
+    ret.max   = std::chrono::nanoseconds(max);
+    ret.p50   = std::chrono::nanoseconds(std::min(percentile(buckets, ret.count, 50), max));
+    ret.p99   = std::chrono::nanoseconds(std::min(percentile(buckets, ret.count, 99), max));
+    return ret;
+  }
+
+private:
+  static constexpr std::size_t kShards  = 4;
+  static constexpr std::size_t kBuckets = 4 * 40;  // up to 2^40 ns (~18 minutes)
+
+  struct alignas(64) Shard
+  {
+    std::array<std::atomic<std::uint64_t>, kBuckets> buckets{};
+    std::atomic<std::uint64_t> failures{0};
+    std::atomic<std::uint64_t> total_ns{0};
+    std::atomic<std::uint64_t> max_ns{0};
+  };
+
+  static std::size_t this_thread_shard() noexcept
+  {
+    static std::atomic<std::size_t> counter{0};
+    thread_local const std::size_t shard = counter.fetch_add(1, std::memory_order_relaxed) % kShards;
+    return shard;
+  }
+
+  /// @brief Bin with 4 sub-bins per power of two.
+  static std::size_t bucket(std::uint64_t ns) noexcept
+  {
+    if (ns < 4) { return static_cast<std::size_t>(ns); }
+    const auto e   = static_cast<std::size_t>(std::bit_width(ns) - 1);
+    const auto sub = static_cast<std::size_t>((ns >> (e - 2)) & 3);
+    return std::min(4 * (e - 1) + sub, kBuckets - 1);
+  }
+
+  /// @brief Midpoint of a bin.
+  static std::uint64_t midpoint(std::size_t b) noexcept
+  {
+    if (b < 4) { return b; }
+    const auto e   = b / 4 + 1;
+    const auto sub = b % 4;
+    return ((4 + sub) << (e - 2)) + ((std::uint64_t{1} << (e - 2)) >> 1);
+  }
+
+  static std::uint64_t percentile(const std::array<std::uint64_t, kBuckets> & buckets, std::uint64_t count, int p)
+  {
+    if (count == 0) { return 0; }
+    const auto rank          = (count * static_cast<std::uint64_t>(p) + 99) / 100;
+    std::uint64_t cumulative = 0;
+    for (auto b = 0u; b < kBuckets; ++b) {
+      cumulative += buckets[b];
+      if (cumulative >= rank) { return midpoint(b); }
+    }
+    return midpoint(kBuckets - 1);
+  }
+
+  std::array<Shard, kShards> m_shards{};
+};
+
+/**
+ * @brief Export metrics snapshots as a json array.
+ *
+ * Times are in nanoseconds.
+ */
+inline std::string MetricsToJson(const std::vector<TagMetricsSnapshot> & metrics)
+{
+  std::string ret = "[";
+  for (auto i = 0u; i < metrics.size(); ++i) {
+    const auto & m = metrics[i];
+    if (i > 0) { ret += ","; }
+    ret += "{\"tag\":\"";
+    for (const char c : m.tag) {
+      if (c == '"' || c == '\\') {
+        ret += '\\';
+        ret += c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        char buf[8];
+        std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+        ret += buf;
+      } else {
+        ret += c;
+      }
+    }
+    ret += "\",\"count\":" + std::to_string(m.count);
+    ret += ",\"failures\":" + std::to_string(m.failures);
+    ret += ",\"total_ns\":" + std::to_string(m.total.count());
+    ret += ",\"p50_ns\":" + std::to_string(m.p50.count());
+    ret += ",\"p99_ns\":" + std::to_string(m.p99.count());
+    ret += ",\"max_ns\":" + std::to_string(m.max.count());
+    ret += "}";
+  }
+  ret += "]";
+  return ret;
+}
+
+}  // namespace ezconfig
@@ -0,0 +1,180 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file parallel.hpp
+ * @brief Executors for parallel creation of independent objects.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ezconfig {
+
+/// @brief Task that is invoked for each index in [0, n).
+using TaskT = std::function<void(std::size_t)>;
+
+// clang-format off
+/**
+ * @brief An executor runs task(i) for all i in [0, n) and returns when all calls have completed.
+ *
+ * The tasks are independent and may run concurrently and in any order. They do not throw.
+ */
+template<typename E>
+concept Executor = requires(E & e, std::size_t n, const TaskT & task) {
+  e(n, task);
+};
+// clang-format on
+
+/**
+ * @brief Executor that runs all tasks on the calling thread.
+ */
+struct SequentialExecutor
+{
+  void operator()(std::size_t n, const TaskT & task) const
+  {
+    for (auto i = 0u; i < n; ++i) { task(i); }
+  }
+};
+
+/**
+ * @brief Executor that runs tasks on a fixed set of worker threads.
+ *
+ * Each call is posted as a job from which idle workers claim indices one at a time, so that slow
+ * and fast tasks are balanced across the workers. The calling thread claims indices as well, which
+ * makes nested calls (e.g. a constructor that itself creates objects in parallel on the same pool)
+ * safe from deadlock.
+ */
+class ThreadPool
+{
+public:
+  /**
+   * @brief Create a thread pool.
+   *
+   * @param num_threads number of worker threads in addition to the calling thread.
+   */
+  explicit ThreadPool(std::size_t num_threads = std::thread::hardware_concurrency())
+  {
+    m_workers.reserve(num_threads);
+    for (auto i = 0u; i < num_threads; ++i) { m_workers.emplace_back([this] { work(); }); }
+  }
+
+  ThreadPool(const ThreadPool &)             = delete;
+  ThreadPool(ThreadPool &&)                  = delete;
+  ThreadPool & operator=(const ThreadPool &) = delete;
+  ThreadPool & operator=(ThreadPool &&)      = delete;
+
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard lock(m_mutex);
+      m_stop = true;
+    }
+    m_cv.notify_all();
+    for (auto & worker : m_workers) { worker.join(); }
+  }
+
+  /// @brief Number of worker threads.
+  std::size_t size() const noexcept { return m_workers.size(); }
+
+  void operator()(std::size_t n, const TaskT & task)
+  {
+    if (n == 0) { return; }
+
+    auto job = std::make_shared<Job>(task, n);
+    {
+      std::lock_guard lock(m_mutex);
+      m_jobs.push_back(job);
+    }
+    m_cv.notify_all();
+
+    run(*job);
+
+    std::unique_lock lock(job->mutex);
+    job->cv.wait(lock, [&] { return job->done.load(std::memory_order_acquire) == n; });
+  }
+
+private:
+  struct Job
+  {
+    Job(const TaskT & t, std::size_t size) : task(t), n(size) {}
+
+    const TaskT & task;
+    const std::size_t n;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> done{0};
+    std::mutex mutex;
+    std::condition_variable cv;
+  };
+
+  /// @brief Claim and run indices until the job is exhausted.
+  void run(Job & job)
+  {
+    for (;;) {
+      const auto i = job.next.fetch_add(1, std::memory_order_relaxed);
+      if (i >= job.n) { break; }
+      job.task(i);
+      if (job.done.fetch_add(1, std::memory_order_acq_rel) + 1 == job.n) {
+        std::lock_guard lock(job.mutex);
+        job.cv.notify_all();
+      }
+    }
+
+    std::lock_guard lock(m_mutex);
+    if (!m_jobs.empty() && m_jobs.front().get() == &job) { m_jobs.pop_front(); }
+  }
+
+  void work()
+  {
+    for (;;) {
+      std::shared_ptr<Job> job;
+      {
+        std::unique_lock lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+        if (m_stop) { return; }
+        job = m_jobs.front();
+      }
+      run(*job);
+    }
+  }
+
+  std::vector<std::thread> m_workers;
+  std::deque<std::shared_ptr<Job>> m_jobs;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_stop{false};
+};
+
+/**
+ * @brief Run task(i) for all i in [0, n) on an executor.
+ *
+ * All tasks run to completion even if some of them throw. Afterwards the exception from the task
+ * with the lowest index is rethrown, so that the outcome does not depend on scheduling.
+ */
+template<Executor E>
+void ParallelFor(E && executor, std::size_t n, const TaskT & task)
+{
+  std::vector<std::exception_ptr> errors(n);
+  const TaskT guarded = [&](std::size_t i) {
+    try {
+      task(i);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  };
+  executor(n, guarded);
+  for (const auto & error : errors) {
+    if (error) { std::rethrow_exception(error); }
+  }
+}
+
+}  // namespace ezconfig
@@ -0,0 +1,157 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file pmr.hpp
+ * @brief Creation of objects in polymorphic memory resources.
+ */
+
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace ezconfig {
+
+/**
+ * @brief Deleter for objects allocated from a std::pmr::memory_resource.
+ *
+ * The deleter remembers the most derived object so that it can be destroyed and deallocated
+ * with the correct size regardless of the pointer type it is called with.
+ */
+struct PmrDeleter
+{
+  /// @brief Memory resource that the object was allocated from.
+  std::pmr::memory_resource * resource{nullptr};
+
+  /// @brief Most derived object.
+  void * object{nullptr};
+
+  /// @brief Destroy and deallocate the most derived object.
+  void (*destroy)(void *, std::pmr::memory_resource *){nullptr};
+
+  void operator()(const void * ptr) const
+  {
+    if (ptr != nullptr && destroy != nullptr) { destroy(object, resource); }
+  }
+};
+
+/**
+ * @brief Unique pointer to an object allocated from a std::pmr::memory_resource.
+ */
+template<typename T>
+using PmrUniquePtr = std::unique_ptr<T, PmrDeleter>;
+
+/**
+ * @brief Create an object in a memory resource.
+ *
+ * The object is constructed with uses-allocator construction, so allocator-aware types (those with
+ * allocator_type = std::pmr::polymorphic_allocator<>) place their own allocations in the resource
+ * as well.
+ *
+ * @tparam Base pointer type.
+ * @tparam Derived object type.
+ *
+ * @param resource memory resource to allocate from (must outlive the object).
+ * @param args constructor arguments.
+ */
+template<typename Base, typename Derived, typename... Args>
+  requires(std::is_convertible_v<Derived *, Base *>)
+PmrUniquePtr<Base> MakePmrUnique(std::pmr::memory_resource * resource, Args &&... args)
+{
+  std::pmr::polymorphic_allocator<> alloc(resource);
+  Derived * obj = alloc.new_object<Derived>(std::forward<Args>(args)...);
+  return PmrUniquePtr<Base>(
+    obj,
+    PmrDeleter{
+      .resource = resource,
+      .object   = obj,
+      .destroy  = [](void * p, std::pmr::memory_resource * r) {
+        std::pmr::polymorphic_allocator<>(r).delete_object(static_cast<Derived *>(p));
+      },
+    });
+}
+
+/**
+ * @brief Wrap a heap-allocated object in a PmrUniquePtr.
+ */
+template<typename Base, typename Derived>
+  requires(std::is_convertible_v<Derived *, Base *>)
+PmrUniquePtr<Base> MakePmrUnique(std::unique_ptr<Derived> && ptr)
+{
+  Derived * obj = ptr.release();
+  return PmrUniquePtr<Base>(
+    obj,
+    PmrDeleter{
+      .resource = nullptr,
+      .object   = obj,
+      .destroy  = [](void * p, std::pmr::memory_resource *) { delete static_cast<Derived *>(p); },
+    });
+}
+
+/**
+ * @brief Arena that owns a graph of objects.
+ *
+ * All memory comes from a std::pmr::monotonic_buffer_resource, so that individual deallocations
+ * are free and everything is released at once when the arena is cleared or destroyed.
+ *
+ * @code
+ * ezconfig::Arena arena;
+ * MyBase * obj = arena.own(ezconfig::yaml::Create<MyBase>(node, arena.resource()));
+ * @endcode
+ */
+class Arena
+{
+public:
+  /**
+   * @brief Create an arena.
+   *
+   * @param initial_size size of the first buffer that is requested from upstream.
+   * @param upstream memory resource that buffers are requested from.
+   */
+  explicit Arena(
+    std::size_t initial_size = 4096, std::pmr::memory_resource * upstream = std::pmr::get_default_resource())
+      : m_resource(initial_size, upstream)
+  {}
+
+  Arena(const Arena &)             = delete;
+  Arena(Arena &&)                  = delete;
+  Arena & operator=(const Arena &) = delete;
+  Arena & operator=(Arena &&)      = delete;
+
+  ~Arena() { clear(); }
+
+  /// @brief Memory resource of the arena.
+  std::pmr::memory_resource * resource() noexcept { return &m_resource; }
+
+  /**
+   * @brief Transfer ownership of an object to the arena.
+   *
+   * The object is destroyed when the arena is cleared or destroyed, in reverse order of ownership.
+   */
+  template<typename T>
+  T * own(PmrUniquePtr<T> && ptr)
+  {
+    m_owned.reserve(m_owned.size() + 1);
+    m_owned.push_back(ptr.get_deleter());
+    return ptr.release();
+  }
+
+  /// @brief Destroy all owned objects and release all memory.
+  void clear()
+  {
+    while (!m_owned.empty()) {
+      const auto deleter = m_owned.back();
+      m_owned.pop_back();
+      deleter(deleter.object);
+    }
+    m_resource.release();
+  }
+
+private:
+  std::pmr::monotonic_buffer_resource m_resource;
+  std::vector<PmrDeleter> m_owned;
+};
+
+}  // namespace ezconfig
@@ -0,0 +1,212 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file ryml.hpp
+ * @brief Yaml factory on top of rapidyaml.
+ *
+ * Include this file in implementation file for the base class and any derived classes.
+ *
+ * rapidyaml parses into a flat, arena-backed tree, which is much faster to build and traverse than
+ * YAML::Node. Objects are created with the same "!tag" convention as ezconfig/yaml.hpp.
+ *
+ * Types are decoded with rapidyaml's own customization point, i.e. an overload
+ * @code
+ * namespace c4::yml {
+ * bool read(ConstNodeRef const & n, T * obj);
+ * }
+ * @endcode
+ * Overloads for the types in ezconfig/yaml_types are in ezconfig/ryml_types.
+ *
+ * @note rapidyaml reports parse errors through its error callback, which by default aborts. Build
+ * rapidyaml with RYML_DEFAULT_CALLBACK_USES_EXCEPTIONS (or set throwing callbacks) to get
+ * exceptions. Errors detected by ezconfig are always thrown.
+ *
+ * @note The namespace ezconfig::ryml hides ::ryml inside namespace ezconfig.
+ */
+
+#pragma once
+
+#include <concepts>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <ryml.hpp>
+#include <ryml_std.hpp>
+
+#include "factory.hpp"
+#include "ryml_fwd.hpp"
+
+/**
+ * @brief Define a global rapidyaml factory for a base class.
+ *
+ * Do this in the base class implementation file.
+ *
+ * @param Base factory base class.
+ *
+ * Example: Define a \a MyBase rapidyaml factory.
+ * @code
+ * EZ_RYML_DEFINE(MyBase);
+ * @endcode
+ */
+#define EZ_RYML_DEFINE(Base)                                                          \
+  EZ_FACTORY_DEFINE(Base, c4::yml::ConstNodeRef);                                     \
+  template std::unique_ptr<Base> ezconfig::ryml::Create<Base>(c4::yml::ConstNodeRef); \
+  template std::shared_ptr<Base> ezconfig::ryml::CreateShared<Base>(c4::yml::ConstNodeRef)
+
+/**
+ * @brief Register a conversion method with the global rapidyaml factory.
+ *
+ * Do this in the implementation files for derived classes.
+ *
+ * @param Base factory base class.
+ * @param tag conversion identifier (constant string that starts with '!', checked at compile time).
+ * @param Derived factory derived class.
+ * @param Intermediate optional intermediate class.
+ *
+ * @note Intermediate can be omitted. In that case Derived must be readable.
+ * @note If provided, Intermediate must be a readable type.
+ *
+ * Example: Register a creator for \a MyDerived with tag "!mytag".
+ * @code
+ * EZ_RYML_REGISTER(MyBase, "!mytag", MyDerived, MyDerivedConfig);
+ * @endcode
+ */
+#define EZ_RYML_REGISTER(Base, tag, Derived, ...)                                 \
+  static_assert(ezconfig::ryml::IsValidTag(tag), "yaml tag must start with !");   \
+  EZ_GLOBAL_REGISTER(                                                             \
+    ([] { ezconfig::ryml::Add<Base, Derived __VA_OPT__(, ) __VA_ARGS__>(tag); }), \
+    ezconfig::GeneralFactory<false, Base, c4::yml::ConstNodeRef>)
+
+namespace c4::yml {
+
+/**
+ * @brief Read std::unique_ptr<Base> using ezconfig::ryml::Create().
+ */
+template<ezconfig::ryml::Constructible Base>
+bool read(ConstNodeRef const & n, std::unique_ptr<Base> * obj)
+{
+  *obj = ::ezconfig::ryml::Create<Base>(n);
+  return true;
+}
+
+/**
+ * @brief Read std::shared_ptr<Base> using ezconfig::ryml::CreateShared().
+ */
+template<ezconfig::ryml::Constructible Base>
+bool read(ConstNodeRef const & n, std::shared_ptr<Base> * obj)
+{
+  *obj = ::ezconfig::ryml::CreateShared<Base>(n);
+  return true;
+}
+
+}  // namespace c4::yml
+
+namespace ezconfig::ryml {
+
+/**
+ * @brief Check if a yaml tag is valid, i.e. of the form "!tag".
+ */
+constexpr bool IsValidTag(std::string_view tag) noexcept { return tag.size() >= 2 && tag[0] == '!'; }
+
+/// @brief View a rapidyaml string.
+inline std::string_view ToStringView(c4::csubstr str) noexcept { return {str.str, str.len}; }
+
+namespace detail {
+
+/// @brief Node type that brings the read() below into overload resolution, see RymlReadable.
+struct ReadProbe : c4::yml::ConstNodeRef
+{};
+
+/// @brief Same signature as the generic c4::yml::read(), a call that only matches the two is ambiguous.
+template<typename T>
+bool read(c4::yml::ConstNodeRef const & n, T * obj);
+
+}  // namespace detail
+
+// clang-format off
+/**
+ * @brief Types that can be read from rapidyaml.
+ *
+ * rapidyaml's generic read() accepts any T but only compiles if there is a from_chars() for T.
+ * A type is therefore readable if it has a from_chars() overload, or a read() overload that is
+ * more specific than the generic one.
+ */
+template<typename T>
+concept RymlReadable = std::default_initializable<T> && (
+  requires(c4::csubstr s, T * obj) { {from_chars(s, obj)} -> std::convertible_to<bool>; }
+  || requires(const detail::ReadProbe & n, T * obj) { {read(n, obj)} -> std::convertible_to<bool>; });
+// clang-format on
+
+/**
+ * @brief Read a value from a node.
+ *
+ * @throws std::runtime_error if the value can not be read.
+ */
+template<RymlReadable T>
+T Get(c4::yml::ConstNodeRef n)
+{
+  T ret{};
+  if (!read(n, &ret)) {
+    std::string msg = "Could not read yaml value";
+    if (n.has_val()) { msg += " '" + std::string(ToStringView(n.val())) + "'"; }
+    throw std::runtime_error(msg);
+  }
+  return ret;
+}
+
+/**
+ * @brief Read the value of a key in a map node.
+ *
+ * @throws std::runtime_error if the key is missing or the value can not be read.
+ */
+template<RymlReadable T>
+T Get(c4::yml::ConstNodeRef n, std::string_view key)
+{
+  const c4::csubstr k(key.data(), key.size());
+  if (!n.is_map() || !n.has_child(k)) { throw std::runtime_error("Missing key '" + std::string(key) + "'"); }
+  return Get<T>(n[k]);
+}
+
+/**
+ * @brief Add a factory method.
+ *
+ * @tparam Derived sub-class of Base.
+ * @tparam Intermediate type that is readable from rapidyaml, and that can construct Derived.
+ *
+ * Adds conversions from yaml of the form
+ *
+ * !tag
+ * object
+ *
+ * to Derived, where object is read as Intermediate.
+ */
+template<typename Base, typename Derived, typename Intermediate = Derived>
+  requires(
+    std::is_base_of_v<Base, Derived> && RymlReadable<Intermediate>
+    && std::is_constructible_v<Derived, Intermediate &&>)
+void Add(std::string_view tag)
+{
+  if (!IsValidTag(tag)) { throw std::logic_error("yaml tag must start with !"); }
+  auto creator        = [](c4::yml::ConstNodeRef n) { return std::make_unique<Derived>(Get<Intermediate>(n)); };
+  auto shared_creator = [](c4::yml::ConstNodeRef n) { return std::make_shared<Derived>(Get<Intermediate>(n)); };
+  EZ_FACTORY_INSTANCE(Base, c4::yml::ConstNodeRef).add(tag, std::move(creator), std::move(shared_creator));
+}
+
+/// @brief Tag of a node, or an empty string if it has none.
+inline std::string_view Tag(c4::yml::ConstNodeRef n) { return n.has_val_tag() ? ToStringView(n.val_tag()) : ""; }
+
+template<typename Base>
+std::unique_ptr<Base> Create(c4::yml::ConstNodeRef n)
+{
+  return EZ_FACTORY_INSTANCE(Base, c4::yml::ConstNodeRef).create(Tag(n), n);
+}
+
+template<typename Base>
+std::shared_ptr<Base> CreateShared(c4::yml::ConstNodeRef n)
+{
+  return EZ_FACTORY_INSTANCE(Base, c4::yml::ConstNodeRef).create_shared(Tag(n), n);
+}
+
+}  // namespace ezconfig::ryml
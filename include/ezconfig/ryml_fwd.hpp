@@ -0,0 +1,66 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file ryml_fwd.hpp
+ * @brief rapidyaml factory forward declarations.
+ *
+ * Include this file in the header for the base class.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "factory.hpp"
+#include "macro.hpp"
+
+/// rapidyaml forward declarations.
+namespace c4::yml {
+class ConstNodeRef;
+}  // namespace c4::yml
+
+namespace ezconfig::ryml {
+
+template<typename T>
+concept Constructible = ::ezconfig::Constructible<T, c4::yml::ConstNodeRef>;
+
+/**
+ * @brief Create an object from a rapidyaml node using the global factory.
+ *
+ * @tparam Base factory base class
+ *
+ * @param n tagged rapidyaml node
+ *
+ * @code
+ * const auto tree = ryml::parse_in_arena(ryml::to_csubstr(data));
+ * auto obj        = ezconfig::ryml::Create<MyBase>(tree.crootref());
+ * @endcode
+ */
+template<typename Base>
+std::unique_ptr<Base> Create(c4::yml::ConstNodeRef n);
+
+/**
+ * @brief Create a shared object from a rapidyaml node using the global factory.
+ *
+ * @tparam Base factory base class
+ *
+ * @param n tagged rapidyaml node
+ */
+template<typename Base>
+std::shared_ptr<Base> CreateShared(c4::yml::ConstNodeRef n);
+
+}  // namespace ezconfig::ryml
+
+/**
+ * @brief Declare a rapidyaml factory for a base class.
+ *
+ * @param Base factory base class.
+ *
+ * The factory creates pointers to Base.
+ *
+ * Example: Declare a \a MyBase rapidyaml factory.
+ * @code
+ * EZ_RYML_DECLARE(MyBase);
+ * @endcode
+ */
+#define EZ_RYML_DECLARE(Base) EZ_FACTORY_DECLARE(Base, c4::yml::ConstNodeRef)
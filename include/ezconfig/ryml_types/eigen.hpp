@@ -0,0 +1,90 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#pragma once
+
+#include <string>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "../ryml.hpp"
+
+namespace c4::yml {
+
+/**
+ * @brief Read an Eigen vector or matrix from rapidyaml.
+ *
+ * Vectors are read from a list, e.g. "[1, 2, 3]", or, for vectors of size at most 3, from a
+ * dictionary like "{x: 1, y: 2, z: 3}". Matrices are read from a list of rows.
+ *
+ * Elements are read directly into the matrix without intermediate containers.
+ */
+template<typename T, int Rows, int Cols, int Opts>
+bool read(ConstNodeRef const & n, Eigen::Matrix<T, Rows, Cols, Opts> * obj)
+{
+  if constexpr (Cols == 1) {
+    if (n.is_seq()) {
+      const auto size = static_cast<Eigen::Index>(n.num_children());
+      if (Rows > 0 && size != Rows) {
+        throw std::runtime_error(
+          "Invalid size of numeric yaml vector: expected '" + std::to_string(Rows) + "' but got '"
+          + std::to_string(size) + "'");
+      }
+      obj->resize(size);
+      Eigen::Index i = 0;
+      for (const auto & child : n.children()) { (*obj)(i++) = ::ezconfig::ryml::Get<T>(child); }
+    } else if (n.is_map()) {
+      if (Rows > 3) { throw std::runtime_error("Map format is only supported for vectors of size at most 3"); }
+      static constexpr const char * kKeys[] = {"x", "y", "z"};
+      Eigen::Index size                     = Rows;
+      if constexpr (Rows < 0) {
+        size = 0;
+        while (size < 3 && n.has_child(to_csubstr(kKeys[size]))) { ++size; }
+      }
+      obj->resize(size);
+      for (Eigen::Index i = 0; i < size; ++i) { (*obj)(i) = ::ezconfig::ryml::Get<T>(n, kKeys[i]); }
+    } else {
+      throw std::runtime_error("Expected sequence or map");
+    }
+  } else {
+    if (!n.is_seq() || n.num_children() == 0) { throw std::runtime_error("Can not parse empty matrix"); }
+    const auto rows = static_cast<Eigen::Index>(n.num_children());
+    const auto cols = static_cast<Eigen::Index>(n.first_child().num_children());
+    if ((Rows > 0 && rows != Rows) || (Cols > 0 && cols != Cols)) {
+      throw std::runtime_error("Invalid size of numeric yaml matrix");
+    }
+    obj->resize(rows, cols);
+    Eigen::Index i = 0;
+    for (const auto & row : n.children()) {
+      if (!row.is_seq() || static_cast<Eigen::Index>(row.num_children()) != cols) {
+        throw std::runtime_error("Not all rows have the same length");
+      }
+      Eigen::Index j = 0;
+      for (const auto & x : row.children()) { (*obj)(i, j++) = ::ezconfig::ryml::Get<T>(x); }
+      ++i;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Read an Eigen quaternion from rapidyaml.
+ *
+ * The yaml representation is a map with keys {w, x, y, z}, or with keys {qw, qx, qy, qz}.
+ */
+template<typename T, int Opts>
+bool read(ConstNodeRef const & n, Eigen::Quaternion<T, Opts> * obj)
+{
+  using ::ezconfig::ryml::Get;
+  if (!n.is_map()) { return false; }
+  if (n.has_child("w")) {
+    *obj = Eigen::Quaternion<T, Opts>(Get<T>(n, "w"), Get<T>(n, "x"), Get<T>(n, "y"), Get<T>(n, "z"));
+  } else if (n.has_child("qw")) {
+    *obj = Eigen::Quaternion<T, Opts>(Get<T>(n, "qw"), Get<T>(n, "qx"), Get<T>(n, "qy"), Get<T>(n, "qz"));
+  } else {
+    throw std::runtime_error("Expected key 'w' or 'qw'");
+  }
+  return true;
+}
+
+}  // namespace c4::yml
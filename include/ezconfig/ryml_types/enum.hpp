@@ -0,0 +1,37 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#pragma once
+
+#include <string_view>
+#include <type_traits>
+
+#include "../ryml.hpp"
+#include "../yaml_types/enum_fwd.hpp"
+#include "../yaml_types/enum_table.hpp"
+
+namespace c4::yml {
+
+/**
+ * @brief Read an enum from rapidyaml.
+ *
+ * Names are matched exactly unless @ref ezconfig::enum_case_insensitive is specialized for T.
+ * Integers are accepted for values without a name.
+ */
+template<ezconfig::ScopedEnum T>
+bool read(ConstNodeRef const & n, T * obj)
+{
+  if (!n.has_val()) { return false; }
+  const auto maybe_val = ezconfig::detail::EnumTable<T>::find(std::string_view(n.val().str, n.val().len));
+  if (maybe_val.has_value()) {
+    *obj = maybe_val.value();
+    return true;
+  }
+  // values without a name are encoded as integers
+  if (std::underlying_type_t<T> val; c4::from_chars(n.val(), &val)) {
+    *obj = static_cast<T>(val);
+    return true;
+  }
+  return false;
+}
+
+}  // namespace c4::yml
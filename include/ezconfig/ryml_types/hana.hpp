@@ -0,0 +1,70 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#pragma once
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+#include "../ryml.hpp"
+#include "../yaml_types/hana_fwd.hpp"
+#include "../yaml_types/hana_table.hpp"
+
+namespace c4::yml {
+
+/**
+ * @brief Read a boost::hana struct from rapidyaml.
+ *
+ * The node must be a map that contains all members. Unknown keys are ignored unless
+ * @ref ezconfig::hana_strict_keys is specialized for T.
+ */
+template<typename T>
+  requires(boost::hana::Struct<T>::value)
+bool read(ConstNodeRef const & n, T * t)
+{
+  using Table = ::ezconfig::detail::HanaStructTable<T>;
+
+  if (!n.is_map()) { return false; }
+
+  std::array<bool, Table::kSize> found{};
+  for (const auto & child : n.children()) {
+    const auto key = ::ezconfig::ryml::ToStringView(child.key());
+    const auto i   = Table::find(key);
+    if (i == Table::kSize) {
+      if constexpr (::ezconfig::hana_strict_keys<T>::value) {
+        throw std::runtime_error("Unknown key '" + std::string(key) + "'");
+      }
+      continue;
+    }
+    if (found[i]) { continue; }
+    found[i] = true;
+    Table::visit(i, *t, [&](auto & member) { member = ::ezconfig::ryml::Get<std::decay_t<decltype(member)>>(child); });
+  }
+
+  for (auto i = 0u; i < Table::kSize; ++i) {
+    if (!found[i]) { throw std::runtime_error("Missing key '" + std::string(Table::kKeys[i]) + "'"); }
+  }
+  return true;
+}
+
+/**
+ * @brief Read std::variant<> from rapidyaml.
+ *
+ * @ref ezconfig::variant_hana_maps must be specialized for std::variant<Ts...>, and the
+ * yaml must contain a tag that matches a key in the map.
+ */
+template<typename... Ts>
+bool read(ConstNodeRef const & n, std::variant<Ts...> * obj)
+{
+  using Table = ::ezconfig::detail::VariantTagTable<std::variant<Ts...>>;
+
+  const auto i = Table::find(::ezconfig::ryml::Tag(n));
+  if (i == Table::kSize) { return false; }
+  Table::visit(i, [&]<typename T, std::size_t J>() { obj->template emplace<J>(::ezconfig::ryml::Get<T>(n)); });
+  return true;
+}
+
+}  // namespace c4::yml
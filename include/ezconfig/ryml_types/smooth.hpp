@@ -0,0 +1,93 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#pragma once
+
+#include <smooth/se2.hpp>
+#include <smooth/se3.hpp>
+#include <smooth/so2.hpp>
+#include <smooth/so3.hpp>
+
+#include "../ryml.hpp"
+#include "eigen.hpp"
+
+namespace c4::yml {
+
+/**
+ * @brief Read so2 from rapidyaml.
+ *
+ * Supported formats: same as for yaml-cpp, see ezconfig/yaml_types/smooth_fwd.hpp.
+ */
+template<typename T>
+bool read(ConstNodeRef const & n, smooth::SO2<T> * obj)
+{
+  using ::ezconfig::ryml::Get;
+  if (n.is_map()) {
+    if (n.has_child("qz")) {
+      *obj = smooth::SO2<T>(Get<T>(n, "qz"), Get<T>(n, "qw"));
+    } else if (n.has_child("z")) {
+      *obj = smooth::SO2<T>(Get<T>(n, "z"), Get<T>(n, "w"));
+    } else {
+      return false;
+    }
+  } else {
+    *obj = smooth::SO2<T>(Get<T>(n));
+  }
+  return true;
+}
+
+/**
+ * @brief Read se2 from rapidyaml.
+ *
+ * Supported formats: same as for yaml-cpp, see ezconfig/yaml_types/smooth_fwd.hpp.
+ */
+template<typename T>
+bool read(ConstNodeRef const & n, smooth::SE2<T> * obj)
+{
+  using ::ezconfig::ryml::Get;
+  if (!n.is_map()) { return false; }
+  if (n.has_child("qw") || n.has_child("w")) {
+    obj->so2() = Get<smooth::SO2<T>>(n);
+    obj->r2()  = Get<Eigen::Vector2<T>>(n);
+  } else if (n.has_child("yaw")) {
+    obj->so2() = Get<smooth::SO2<T>>(n, "yaw");
+    obj->r2()  = Get<Eigen::Vector2<T>>(n);
+  } else {
+    obj->so2() = Get<smooth::SO2<T>>(n, "orientation");
+    obj->r2()  = Get<Eigen::Vector2<T>>(n, "translation");
+  }
+  return true;
+}
+
+/**
+ * @brief Read so3 from rapidyaml.
+ *
+ * Supported formats: same as Eigen quaternion.
+ */
+template<typename T>
+bool read(ConstNodeRef const & n, smooth::SO3<T> * obj)
+{
+  *obj = smooth::SO3<T>(::ezconfig::ryml::Get<Eigen::Quaternion<T>>(n));
+  return true;
+}
+
+/**
+ * @brief Read se3 from rapidyaml.
+ *
+ * Supported formats: same as for yaml-cpp, see ezconfig/yaml_types/smooth_fwd.hpp.
+ */
+template<typename T>
+bool read(ConstNodeRef const & n, smooth::SE3<T> * obj)
+{
+  using ::ezconfig::ryml::Get;
+  if (!n.is_map()) { return false; }
+  if (n.has_child("qw")) {
+    obj->so3() = Get<smooth::SO3<T>>(n);
+    obj->r3()  = Get<Eigen::Vector3<T>>(n);
+  } else {
+    obj->so3() = Get<smooth::SO3<T>>(n, "orientation");
+    obj->r3()  = Get<Eigen::Vector3<T>>(n, "translation");
+  }
+  return true;
+}
+
+}  // namespace c4::yml
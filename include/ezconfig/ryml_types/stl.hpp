@@ -0,0 +1,96 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+
+#include "../duration.hpp"
+#include "../ryml.hpp"
+
+namespace c4::yml {
+
+/**
+ * @brief Read std::optional<> from rapidyaml.
+ *
+ * A yaml "null" value is mapped to std::nullopt.
+ */
+template<typename T>
+bool read(ConstNodeRef const & n, std::optional<T> * obj)
+{
+  if (n.has_val() && n.val_is_null()) {
+    *obj = std::nullopt;
+  } else {
+    *obj = ::ezconfig::ryml::Get<T>(n);
+  }
+  return true;
+}
+
+/**
+ * @brief Read strings (also with non-default allocators, e.g. std::pmr::string) from rapidyaml.
+ *
+ * The string keeps its allocator.
+ */
+template<typename A>
+bool read(ConstNodeRef const & n, std::basic_string<char, std::char_traits<char>, A> * obj)
+{
+  if (!n.has_val()) { return false; }
+  obj->assign(n.val().str, n.val().len);
+  return true;
+}
+
+/**
+ * @brief Read a std::unordered_map from rapidyaml.
+ */
+template<typename K, typename V, typename H, typename E, typename A>
+bool read(ConstNodeRef const & n, std::unordered_map<K, V, H, E, A> * obj)
+{
+  if (!n.is_map()) { return false; }
+  obj->clear();
+  for (const auto & child : n.children()) {
+    K key{};
+    if (!from_chars(child.key(), &key)) { return false; }
+    if (!obj->emplace(std::move(key), ::ezconfig::ryml::Get<V>(child)).second) {
+      throw std::runtime_error("Double key '" + std::string(::ezconfig::ryml::ToStringView(child.key())) + "' in map");
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Read a path from rapidyaml.
+ */
+inline bool read(ConstNodeRef const & n, std::filesystem::path * obj)
+{
+  if (!n.has_val()) { return false; }
+  *obj = std::string_view(n.val().str, n.val().len);
+  return true;
+}
+
+/**
+ * @brief Read a chrono type from rapidyaml.
+ *
+ * The yaml representation is e.g. "40ms", "1.5s" or "1h30m", see ezconfig::ParseDuration() for the
+ * supported formats.
+ */
+template<typename Rep, typename Period>
+bool read(ConstNodeRef const & n, std::chrono::duration<Rep, Period> * obj)
+{
+  if (!n.has_val()) { return false; }
+  const auto str = ::ezconfig::ryml::ToStringView(n.val());
+  const auto ec = ::ezconfig::ParseDuration(str, *obj);
+  if (ec == std::errc::result_out_of_range) {
+    throw std::runtime_error("Duration '" + std::string(str) + "' is out of range");
+  }
+  if (ec != std::errc{}) {
+    throw std::runtime_error(
+      "Could not parse duration '" + std::string(str) + "', expected e.g. 40ms, 1.5s, or 1h30m");
+  }
+  return true;
+}
+
+}  // namespace c4::yml
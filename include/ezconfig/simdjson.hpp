@@ -0,0 +1,292 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file simdjson.hpp
+ * @brief Json factory on top of the simdjson on-demand API.
+ *
+ * Include this file in implementation file for the base class and any derived classes.
+ *
+ * Objects are created directly from the parser without building a DOM. Types are decoded with
+ * ezconfig::simdjson::Decoder, which is specialized for arithmetic types, strings, std::vector,
+ * std::map, and factory pointers.
+ *
+ * @note The namespace ezconfig::simdjson hides ::simdjson inside namespace ezconfig.
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <simdjson.h>
+
+#include "factory.hpp"
+#include "simdjson_fwd.hpp"
+
+#if !SIMDJSON_EXCEPTIONS
+#error "ezconfig/simdjson.hpp requires SIMDJSON_EXCEPTIONS"
+#endif
+
+/**
+ * @brief Define a global simdjson factory for a base class.
+ *
+ * Do this in the base class implementation file.
+ *
+ * @param Base factory base class.
+ *
+ * Example: Define a \a MyBase simdjson factory.
+ * @code
+ * EZ_SIMDJSON_DEFINE(MyBase);
+ * @endcode
+ */
+#define EZ_SIMDJSON_DEFINE(Base)                                                                      \
+  EZ_FACTORY_DEFINE(Base, ::simdjson::ondemand::value);                                               \
+  template std::unique_ptr<Base> ezconfig::simdjson::Create<Base>(::simdjson::ondemand::value);       \
+  template std::shared_ptr<Base> ezconfig::simdjson::CreateShared<Base>(::simdjson::ondemand::value); \
+  template struct ezconfig::simdjson::Decoder<std::unique_ptr<Base>>;                                 \
+  template struct ezconfig::simdjson::Decoder<std::shared_ptr<Base>>
+
+/**
+ * @brief Register a tagged conversion with a simdjson factory.
+ *
+ * Do this in the implementation files for derived classes.
+ *
+ * @param Base factory base class.
+ * @param tag conversion identifier (constant non-empty string, checked at compile time).
+ * @param Derived factory derived class.
+ * @param Intermediate optional intermediate class.
+ *
+ * @note Intermediate can be omitted. In that case Derived must be decodable.
+ * @note If provided, Intermediate must be decodable, see ezconfig::simdjson::Decoder.
+ *
+ * Example: Register a creator for \a MyDerived with tag "mytag".
+ * @code
+ * EZ_SIMDJSON_REGISTER(MyBase, "mytag", MyDerived, MyDerivedConfig);
+ * @endcode
+ */
+#define EZ_SIMDJSON_REGISTER(Base, tag, Derived, ...)                                 \
+  static_assert(ezconfig::simdjson::IsValidTag(tag), "json tag must not be empty");   \
+  EZ_GLOBAL_REGISTER(                                                                 \
+    ([] { ezconfig::simdjson::Add<Base, Derived __VA_OPT__(, ) __VA_ARGS__>(tag); }), \
+    ezconfig::GeneralFactory<false, Base, ::simdjson::ondemand::value>)
+
+namespace ezconfig::simdjson {
+
+/**
+ * @brief Check if a json tag is valid, i.e. non-empty.
+ */
+constexpr bool IsValidTag(std::string_view tag) noexcept { return !tag.empty(); }
+
+// clang-format off
+template<typename T>
+concept Decodable = requires(::simdjson::ondemand::value v) {
+  {Decoder<T>::decode(v)} -> std::convertible_to<T>;
+};
+// clang-format on
+
+/**
+ * @brief Decode a value.
+ */
+template<Decodable T>
+T Decode(::simdjson::ondemand::value v)
+{
+  return Decoder<T>::decode(v);
+}
+
+template<>
+struct Decoder<bool>
+{
+  static bool decode(::simdjson::ondemand::value v) { return v.get_bool(); }
+};
+
+template<std::integral T>
+  requires(!std::is_same_v<T, bool>)
+struct Decoder<T>
+{
+  static T decode(::simdjson::ondemand::value v)
+  {
+    if constexpr (std::is_signed_v<T>) {
+      const std::int64_t x = v.get_int64();
+      if (!std::in_range<T>(x)) { throw std::out_of_range("Integer " + std::to_string(x) + " out of range"); }
+      return static_cast<T>(x);
+    } else {
+      const std::uint64_t x = v.get_uint64();
+      if (!std::in_range<T>(x)) { throw std::out_of_range("Integer " + std::to_string(x) + " out of range"); }
+      return static_cast<T>(x);
+    }
+  }
+};
+
+template<std::floating_point T>
+struct Decoder<T>
+{
+  static T decode(::simdjson::ondemand::value v) { return static_cast<T>(static_cast<double>(v.get_double())); }
+};
+
+template<typename C, typename A>
+struct Decoder<std::basic_string<char, C, A>>
+{
+  static std::basic_string<char, C, A> decode(::simdjson::ondemand::value v)
+  {
+    const std::string_view str = v.get_string();
+    return std::basic_string<char, C, A>(str.data(), str.size());
+  }
+};
+
+template<Decodable T, typename A>
+struct Decoder<std::vector<T, A>>
+{
+  static std::vector<T, A> decode(::simdjson::ondemand::value v)
+  {
+    std::vector<T, A> ret;
+    for (::simdjson::ondemand::value x : v.get_array()) { ret.push_back(Decoder<T>::decode(x)); }
+    return ret;
+  }
+};
+
+template<Decodable T, typename Cmp, typename A>
+struct Decoder<std::map<std::string, T, Cmp, A>>
+{
+  static std::map<std::string, T, Cmp, A> decode(::simdjson::ondemand::value v)
+  {
+    std::map<std::string, T, Cmp, A> ret;
+    for (::simdjson::ondemand::field field : v.get_object()) {
+      const std::string_view key = field.unescaped_key();
+      if (!ret.emplace(std::string(key), Decoder<T>::decode(field.value())).second) {
+        throw std::logic_error("Double key '" + std::string(key) + "' in map");
+      }
+    }
+    return ret;
+  }
+};
+
+/**
+ * @brief Decoder for std::unique_ptr<Base> using simdjson::Create().
+ */
+template<Constructible Base>
+struct Decoder<std::unique_ptr<Base>>
+{
+  static std::unique_ptr<Base> decode(::simdjson::ondemand::value v);
+};
+
+/**
+ * @brief Decoder for std::shared_ptr<Base> using simdjson::CreateShared().
+ */
+template<Constructible Base>
+struct Decoder<std::shared_ptr<Base>>
+{
+  static std::shared_ptr<Base> decode(::simdjson::ondemand::value v);
+};
+
+/**
+ * @brief Add a factory method.
+ *
+ * @tparam Derived sub-class of Base.
+ * @tparam Intermediate type that is decodable, and that can construct Derived.
+ *
+ * Adds conversions from json of the form
+ *
+ * {"tag": object}
+ *
+ * to Derived, where object is decoded to Intermediate.
+ */
+template<typename Base, typename Derived, typename Intermediate = Derived>
+  requires(
+    std::is_base_of_v<Base, Derived> && Decodable<Intermediate> && std::is_constructible_v<Derived, Intermediate &&>)
+void Add(std::string_view tag)
+{
+  auto creator = [](::simdjson::ondemand::value v) {
+    return std::make_unique<Derived>(Decoder<Intermediate>::decode(v));
+  };
+  auto shared_creator = [](::simdjson::ondemand::value v) {
+    return std::make_shared<Derived>(Decoder<Intermediate>::decode(v));
+  };
+  EZ_FACTORY_INSTANCE(Base, ::simdjson::ondemand::value).add(tag, std::move(creator), std::move(shared_creator));
+}
+
+namespace detail {
+
+/// @brief Invoke f(tag, object) for a json value of format {tag: object}.
+template<typename F>
+auto WithTag(::simdjson::ondemand::value v, F && f)
+{
+  decltype(f(std::string_view{}, v)) ret;
+  bool found = false;
+  for (::simdjson::ondemand::field field : v.get_object()) {
+    if (found) { throw std::logic_error("Expected dictionary of size 1 of format {tag: object}"); }
+    found                      = true;
+    const std::string_view tag = field.unescaped_key();
+    ret                        = f(tag, field.value());
+  }
+  if (!found) { throw std::logic_error("Expected dictionary of size 1 of format {tag: object}"); }
+  return ret;
+}
+
+}  // namespace detail
+
+template<typename Base>
+std::unique_ptr<Base> Create(::simdjson::ondemand::value v)
+{
+  return detail::WithTag(v, [](std::string_view tag, ::simdjson::ondemand::value obj) {
+    return EZ_FACTORY_INSTANCE(Base, ::simdjson::ondemand::value).create(tag, obj);
+  });
+}
+
+template<typename Base>
+std::shared_ptr<Base> CreateShared(::simdjson::ondemand::value v)
+{
+  return detail::WithTag(v, [](std::string_view tag, ::simdjson::ondemand::value obj) {
+    return EZ_FACTORY_INSTANCE(Base, ::simdjson::ondemand::value).create_shared(tag, obj);
+  });
+}
+
+/**
+ * @brief Parse and decode a json document.
+ *
+ * @param parser parser to use (reusing a parser avoids re-allocating its buffers).
+ * @param json padded json data, e.g. from ::simdjson::padded_string::load().
+ *
+ * @code
+ * ::simdjson::ondemand::parser parser;
+ * auto objs = ezconfig::simdjson::Get<std::vector<std::unique_ptr<MyBase>>>(parser, json);
+ * @endcode
+ */
+template<Decodable T>
+T Get(::simdjson::ondemand::parser & parser, const ::simdjson::padded_string & json)
+{
+  ::simdjson::ondemand::document doc = parser.iterate(json);
+  T ret                              = Decoder<T>::decode(doc.get_value());
+  if (!doc.at_end()) { throw std::logic_error("Unexpected trailing json content"); }
+  return ret;
+}
+
+/**
+ * @brief Parse and decode a json document with a temporary parser.
+ */
+template<Decodable T>
+T Get(const ::simdjson::padded_string & json)
+{
+  ::simdjson::ondemand::parser parser;
+  return Get<T>(parser, json);
+}
+
+}  // namespace ezconfig::simdjson
+
+template<ezconfig::simdjson::Constructible Base>
+std::unique_ptr<Base> ezconfig::simdjson::Decoder<std::unique_ptr<Base>>::decode(::simdjson::ondemand::value v)
+{
+  return ::ezconfig::simdjson::Create<Base>(v);
+}
+
+template<ezconfig::simdjson::Constructible Base>
+std::shared_ptr<Base> ezconfig::simdjson::Decoder<std::shared_ptr<Base>>::decode(::simdjson::ondemand::value v)
+{
+  return ::ezconfig::simdjson::CreateShared<Base>(v);
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file simdjson_fwd.hpp
+ * @brief simdjson factory forward declarations.
+ *
+ * Include this file in the header for the base class.
+ *
+ * @note simdjson does not have a forward declaration header, so this includes simdjson.h.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <simdjson.h>
+
+#include "factory.hpp"
+#include "macro.hpp"
+
+namespace ezconfig::simdjson {
+
+template<typename T>
+concept Constructible = ::ezconfig::Constructible<T, ::simdjson::ondemand::value>;
+
+/**
+ * @brief Conversion from an on-demand value to T.
+ *
+ * Specialize and implement
+ * @code
+ * static T decode(::simdjson::ondemand::value v);
+ * @endcode
+ * to make T decodable. The value must be consumed exactly once.
+ */
+template<typename T>
+struct Decoder;
+
+/**
+ * @brief Create an object using the global factory.
+ *
+ * @tparam Base factory base class
+ *
+ * @param v on-demand json value of format {tag: object}
+ *
+ * @code
+ * ::simdjson::ondemand::parser parser;
+ * auto doc = parser.iterate(json);
+ * auto obj = ezconfig::simdjson::Create<MyBase>(doc.get_value());
+ * @endcode
+ */
+template<typename Base>
+std::unique_ptr<Base> Create(::simdjson::ondemand::value v);
+
+/**
+ * @brief Create a shared object using the global factory.
+ *
+ * @tparam Base factory base class
+ *
+ * @param v on-demand json value of format {tag: object}
+ */
+template<typename Base>
+std::shared_ptr<Base> CreateShared(::simdjson::ondemand::value v);
+
+}  // namespace ezconfig::simdjson
+
+/**
+ * @brief Declare a simdjson factory for a base class.
+ *
+ * @param Base factory base class.
+ *
+ * The factory creates pointers to Base.
+ *
+ * Example: Declare a \a MyBase simdjson factory.
+ * @code
+ * EZ_SIMDJSON_DECLARE(MyBase);
+ * @endcode
+ */
+#define EZ_SIMDJSON_DECLARE(Base) EZ_FACTORY_DECLARE(Base, ::simdjson::ondemand::value)
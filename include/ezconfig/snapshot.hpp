@@ -0,0 +1,514 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file snapshot.hpp
+ * @brief Binary snapshots of decoded configs.
+ *
+ * A snapshot stores the intermediate types that objects are created from, so that a config can be
+ * re-created without parsing it again, see yaml::LoadFileCached().
+ *
+ * Types are made serializable by specializing Serializer. Snapshots are only meant to be read by
+ * the same build on the same machine, values are stored in native byte order.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ezconfig {
+
+class SnapshotWriter;
+class SnapshotReader;
+
+/**
+ * @brief Binary serialization of T in snapshots.
+ *
+ * Specialize and implement
+ * @code
+ * static void write(SnapshotWriter & w, const T & obj);
+ * static T read(SnapshotReader & r);
+ * @endcode
+ * to make T serializable. Optionally define
+ * @code
+ * static constexpr std::uint32_t version = 1;
+ * static std::uint64_t schema() { return SchemaHashOf<Member1, Member2>(); }
+ * @endcode
+ * where schema() lists the types that are serialized as part of T, so that changes to them
+ * invalidate existing snapshots of T (see SchemaHash()), and version is bumped whenever the binary
+ * layout changes in some other way.
+ */
+template<typename T>
+struct Serializer;
+
+// clang-format off
+template<typename T>
+concept Serializable = requires(SnapshotWriter & w, SnapshotReader & r, const T & obj) {
+  {Serializer<T>::write(w, obj)};
+  {Serializer<T>::read(r)} -> std::convertible_to<T>;
+};
+// clang-format on
+
+/**
+ * @brief 64 bit hash of a byte range.
+ *
+ * Processes eight bytes at a time. Not cryptographic, only used to detect changes.
+ */
+inline std::uint64_t HashBytes(std::string_view data, std::uint64_t seed = 0) noexcept
+{
+  constexpr auto mix = [](std::uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+  };
+
+  std::uint64_t h = mix(seed ^ (data.size() * 0x9e3779b97f4a7c15ull));
+  std::size_t i   = 0;
+  for (; i + 8 <= data.size(); i += 8) {
+    std::uint64_t w;
+    std::memcpy(&w, data.data() + i, 8);
+    h = (h ^ mix(w)) * 0x9e3779b97f4a7c15ull;
+    h ^= h >> 29;
+  }
+  std::uint64_t w = 0;
+  if (i < data.size()) { std::memcpy(&w, data.data() + i, data.size() - i); }
+  return mix(h ^ mix(w));
+}
+
+/**
+ * @brief Hash of the snapshot schema of T.
+ *
+ * Covers the type name, size, and Serializer version of T, and recursively the schemas returned by
+ * Serializer<T>::schema() if present. The serializers of containers include their elements, so
+ * that e.g. the schema of std::vector<T> changes with that of T. Snapshots of objects whose schema
+ * hash changed are not read.
+ */
+template<Serializable T>
+std::uint64_t SchemaHash()
+{
+  std::uint64_t version = 0;
+  if constexpr (requires { Serializer<T>::version; }) { version = Serializer<T>::version; }
+  const auto hash = HashBytes(typeid(T).name(), (sizeof(T) << 32) ^ version);
+  if constexpr (requires { Serializer<T>::schema(); }) {
+    return HashBytes(typeid(T).name(), hash ^ Serializer<T>::schema());
+  } else {
+    return hash;
+  }
+}
+
+/**
+ * @brief Combined schema hash of several types, for use in Serializer::schema().
+ */
+template<Serializable... Ts>
+std::uint64_t SchemaHashOf()
+{
+  const std::array<std::uint64_t, sizeof...(Ts)> hashes{SchemaHash<Ts>()...};
+  return HashBytes(std::string_view(reinterpret_cast<const char *>(hashes.data()), sizeof(hashes)));
+}
+
+/**
+ * @brief Snapshot output buffer.
+ */
+class SnapshotWriter
+{
+public:
+  /// @brief Write raw bytes.
+  void write_bytes(const void * data, std::size_t size) { m_data.append(static_cast<const char *>(data), size); }
+
+  /// @brief Write a size prefixed string.
+  void write_string(std::string_view str)
+  {
+    const auto size = static_cast<std::uint64_t>(str.size());
+    write_bytes(&size, sizeof(size));
+    write_bytes(str.data(), str.size());
+  }
+
+  /// @brief Write a serializable value.
+  template<Serializable T>
+  void write(const T & obj)
+  {
+    Serializer<T>::write(*this, obj);
+  }
+
+  /// @brief Written data.
+  const std::string & data() const & noexcept { return m_data; }
+
+  /// @brief Take the written data.
+  std::string data() && noexcept { return std::move(m_data); }
+
+private:
+  std::string m_data;
+};
+
+/**
+ * @brief Snapshot input buffer.
+ *
+ * The reader does not own the data.
+ *
+ * @throws std::runtime_error on reads past the end of the data.
+ */
+class SnapshotReader
+{
+public:
+  explicit SnapshotReader(std::string_view data) : m_data(data) {}
+
+  /// @brief Read raw bytes.
+  std::string_view read_bytes(std::size_t size)
+  {
+    if (size > m_data.size() - m_pos) { throw std::runtime_error("Truncated snapshot"); }
+    const auto ret = m_data.substr(m_pos, size);
+    m_pos += size;
+    return ret;
+  }
+
+  /// @brief Read a size prefixed string, valid as long as the data.
+  std::string_view read_string() { return read_bytes(read_size(1)); }
+
+  /// @brief Read a size, checked against the remaining data for elements of at least min_bytes.
+  std::size_t read_size(std::size_t min_bytes)
+  {
+    std::uint64_t size;
+    std::memcpy(&size, read_bytes(sizeof(size)).data(), sizeof(size));
+    if (min_bytes > 0 && size > (m_data.size() - m_pos) / min_bytes) { throw std::runtime_error("Truncated snapshot"); }
+    return static_cast<std::size_t>(size);
+  }
+
+  /// @brief Read a serializable value.
+  template<Serializable T>
+  T read()
+  {
+    return Serializer<T>::read(*this);
+  }
+
+  /// @brief Whether all data has been read.
+  bool at_end() const noexcept { return m_pos == m_data.size(); }
+
+private:
+  std::string_view m_data;
+  std::size_t m_pos{0};
+};
+
+/**
+ * @brief Error for objects that can not be snapshotted.
+ */
+struct SnapshotError : public std::runtime_error
+{
+  using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Records the serialized intermediates of objects while they are created.
+ *
+ * While a recorder is alive, creators registered with yaml::AddSnapshot() record each object they
+ * create on the same thread, so that objects can be serialized by address afterwards (see
+ * yaml::LoadFileCached()).
+ */
+class SnapshotRecorder
+{
+public:
+  SnapshotRecorder() : m_prev(std::exchange(active_ref(), this)) {}
+  SnapshotRecorder(const SnapshotRecorder &)             = delete;
+  SnapshotRecorder & operator=(const SnapshotRecorder &) = delete;
+  ~SnapshotRecorder() { active_ref() = m_prev; }
+
+  /// @brief Recorder of the current thread, or nullptr.
+  static SnapshotRecorder * active() noexcept { return active_ref(); }
+
+  /// @brief Record the snapshot of an object.
+  void record(const void * obj, std::string data) { m_objects.insert_or_assign(obj, std::move(data)); }
+
+  /**
+   * @brief Snapshot of an object.
+   *
+   * @throws SnapshotError if the object was not recorded.
+   */
+  const std::string & find(const void * obj) const
+  {
+    if (const auto it = m_objects.find(obj); it != m_objects.end()) { return it->second; }
+    throw SnapshotError("Object was not recorded for snapshot");
+  }
+
+  /**
+   * @brief Remove the snapshot of an object from the recording.
+   *
+   * Used when the snapshot is written into that of its owner, so that nested objects are not held
+   * once per level.
+   *
+   * @throws SnapshotError if the object was not recorded.
+   */
+  std::string take(const void * obj)
+  {
+    auto node = m_objects.extract(obj);
+    if (node.empty()) { throw SnapshotError("Object was not recorded for snapshot"); }
+    return std::move(node.mapped());
+  }
+
+private:
+  static SnapshotRecorder *& active_ref() noexcept
+  {
+    static thread_local SnapshotRecorder * active = nullptr;
+    return active;
+  }
+
+  SnapshotRecorder * m_prev;
+  std::unordered_map<const void *, std::string> m_objects;
+};
+
+/**
+ * @brief Write a snapshot file.
+ *
+ * The data is written to a temporary file with a unique name that then replaces the file, so
+ * readers never see a partially written snapshot, also when several processes write the snapshot
+ * at the same time.
+ *
+ * @throws std::runtime_error or std::filesystem::filesystem_error if the file can not be written.
+ */
+inline void WriteSnapshotFile(const std::filesystem::path & path, std::string_view data)
+{
+  static std::atomic<std::uint64_t> counter{0};
+  const auto unique = HashBytes(
+    std::to_string(std::random_device{}()) + std::to_string(counter++),
+    static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()));
+
+  char suffix[17];
+  std::snprintf(suffix, sizeof(suffix), "%016llx", static_cast<unsigned long long>(unique));
+  auto tmp = path;
+  tmp += ".tmp.";
+  tmp += suffix;
+
+  try {
+    {
+      std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+      out.write(data.data(), static_cast<std::streamsize>(data.size()));
+      if (!out.flush()) { throw std::runtime_error("Could not write snapshot '" + tmp.string() + "'"); }
+    }
+    std::filesystem::rename(tmp, path);
+  } catch (...) {
+    std::error_code ec;
+    std::filesystem::remove(tmp, ec);
+    throw;
+  }
+}
+
+/// @brief Serializer for arithmetic types and enums.
+template<typename T>
+  requires(std::is_arithmetic_v<T> || std::is_enum_v<T>)
+struct Serializer<T>
+{
+  static void write(SnapshotWriter & w, const T & obj) { w.write_bytes(&obj, sizeof(T)); }
+
+  static T read(SnapshotReader & r)
+  {
+    T ret;
+    std::memcpy(&ret, r.read_bytes(sizeof(T)).data(), sizeof(T));
+    return ret;
+  }
+};
+
+/// @brief Serializer for strings.
+template<typename Traits, typename A>
+struct Serializer<std::basic_string<char, Traits, A>>
+{
+  static void write(SnapshotWriter & w, const std::basic_string<char, Traits, A> & obj) { w.write_string(obj); }
+
+  static std::basic_string<char, Traits, A> read(SnapshotReader & r)
+  {
+    const auto str = r.read_string();
+    return std::basic_string<char, Traits, A>(str.data(), str.size());
+  }
+};
+
+/// @brief Serializer for paths.
+template<>
+struct Serializer<std::filesystem::path>
+{
+  static void write(SnapshotWriter & w, const std::filesystem::path & obj) { w.write_string(obj.native()); }
+
+  static std::filesystem::path read(SnapshotReader & r) { return std::filesystem::path(r.read_string()); }
+};
+
+/// @brief Serializer for durations.
+template<Serializable Rep, typename Period>
+struct Serializer<std::chrono::duration<Rep, Period>>
+{
+  static std::uint64_t schema() { return SchemaHashOf<Rep>(); }
+
+  static void write(SnapshotWriter & w, const std::chrono::duration<Rep, Period> & obj) { w.write(obj.count()); }
+
+  static std::chrono::duration<Rep, Period> read(SnapshotReader & r)
+  {
+    return std::chrono::duration<Rep, Period>(r.read<Rep>());
+  }
+};
+
+/// @brief Serializer for optionals.
+template<Serializable T>
+struct Serializer<std::optional<T>>
+{
+  static std::uint64_t schema() { return SchemaHashOf<T>(); }
+
+  static void write(SnapshotWriter & w, const std::optional<T> & obj)
+  {
+    w.write(obj.has_value());
+    if (obj.has_value()) { w.write(*obj); }
+  }
+
+  static std::optional<T> read(SnapshotReader & r)
+  {
+    if (!r.read<bool>()) { return std::nullopt; }
+    return r.read<T>();
+  }
+};
+
+/// @brief Serializer for pairs.
+template<Serializable T1, Serializable T2>
+struct Serializer<std::pair<T1, T2>>
+{
+  static std::uint64_t schema() { return SchemaHashOf<T1, T2>(); }
+
+  static void write(SnapshotWriter & w, const std::pair<T1, T2> & obj)
+  {
+    w.write(obj.first);
+    w.write(obj.second);
+  }
+
+  static std::pair<T1, T2> read(SnapshotReader & r)
+  {
+    auto first = r.read<T1>();
+    return {std::move(first), r.read<T2>()};
+  }
+};
+
+/// @brief Serializer for arrays.
+template<Serializable T, std::size_t N>
+struct Serializer<std::array<T, N>>
+{
+  static std::uint64_t schema() { return SchemaHashOf<T>(); }
+
+  static void write(SnapshotWriter & w, const std::array<T, N> & obj)
+  {
+    for (const auto & x : obj) { w.write(x); }
+  }
+
+  static std::array<T, N> read(SnapshotReader & r)
+  {
+    std::array<T, N> ret;
+    for (auto & x : ret) { x = r.read<T>(); }
+    return ret;
+  }
+};
+
+/// @brief Serializer for vectors, arithmetic elements are copied in bulk.
+template<Serializable T, typename A>
+struct Serializer<std::vector<T, A>>
+{
+  static std::uint64_t schema() { return SchemaHashOf<T>(); }
+
+  static void write(SnapshotWriter & w, const std::vector<T, A> & obj)
+  {
+    w.write(static_cast<std::uint64_t>(obj.size()));
+    if constexpr (std::is_arithmetic_v<T>) {
+      w.write_bytes(obj.data(), obj.size() * sizeof(T));
+    } else {
+      for (const auto & x : obj) { w.write(x); }
+    }
+  }
+
+  static std::vector<T, A> read(SnapshotReader & r)
+  {
+    const auto size = r.read_size(std::is_arithmetic_v<T> ? sizeof(T) : 1);
+    std::vector<T, A> ret;
+    if constexpr (std::is_arithmetic_v<T>) {
+      const auto bytes = r.read_bytes(size * sizeof(T));
+      ret.resize(size);
+      if (size > 0) { std::memcpy(ret.data(), bytes.data(), bytes.size()); }
+    } else {
+      ret.reserve(size);
+      for (auto i = 0u; i < size; ++i) { ret.push_back(r.read<T>()); }
+    }
+    return ret;
+  }
+};
+
+/// @brief Serializer for vectors of bool.
+template<typename A>
+struct Serializer<std::vector<bool, A>>
+{
+  static void write(SnapshotWriter & w, const std::vector<bool, A> & obj)
+  {
+    w.write(static_cast<std::uint64_t>(obj.size()));
+    for (const bool x : obj) { w.write(x); }
+  }
+
+  static std::vector<bool, A> read(SnapshotReader & r)
+  {
+    std::vector<bool, A> ret(r.read_size(1));
+    for (auto && x : ret) { x = r.read<bool>(); }
+    return ret;
+  }
+};
+
+namespace detail {
+
+/// @brief Serializer for maps.
+template<typename Map>
+struct MapSerializer
+{
+  static std::uint64_t schema() { return SchemaHashOf<typename Map::key_type, typename Map::mapped_type>(); }
+
+  static void write(SnapshotWriter & w, const Map & obj)
+  {
+    w.write(static_cast<std::uint64_t>(obj.size()));
+    for (const auto & [k, v] : obj) {
+      w.write(k);
+      w.write(v);
+    }
+  }
+
+  static Map read(SnapshotReader & r)
+  {
+    const auto size = r.read_size(1);
+    Map ret;
+    if constexpr (requires { ret.reserve(size); }) { ret.reserve(size); }
+    for (auto i = 0u; i < size; ++i) {
+      auto k = r.read<typename Map::key_type>();
+      ret.emplace(std::move(k), r.read<typename Map::mapped_type>());
+    }
+    return ret;
+  }
+};
+
+}  // namespace detail
+
+/// @brief Serializer for maps.
+template<Serializable K, Serializable V, typename C, typename A>
+struct Serializer<std::map<K, V, C, A>> : detail::MapSerializer<std::map<K, V, C, A>>
+{};
+
+/// @brief Serializer for unordered maps.
+template<Serializable K, Serializable V, typename H, typename E, typename A>
+struct Serializer<std::unordered_map<K, V, H, E, A>> : detail::MapSerializer<std::unordered_map<K, V, H, E, A>>
+{};
+
+}  // namespace ezconfig
@@ -0,0 +1,397 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file tag_map.hpp
+ * @brief Flat hash map from string tags to values.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ezconfig {
+
+/**
+ * @brief Hash a tag (64-bit FNV-1a).
+ */
+constexpr std::uint64_t TagHash(std::string_view tag) noexcept
+{
+  std::uint64_t h = 0xcbf29ce484222325ull;
+  for (const char c : tag) {
+    h ^= static_cast<std::uint8_t>(c);
+    h *= 0x100000001b3ull;
+  }
+  return h;
+}
+
+/**
+ * @brief Tag with a precomputed hash.
+ *
+ * Create with the _tag literal to hash at compile time.
+ */
+struct Tag
+{
+  std::string_view str;
+  std::uint64_t hash;
+};
+
+namespace literals {
+
+/**
+ * @brief Tag literal that is hashed at compile time.
+ *
+ * @code
+ * using namespace ezconfig::literals;
+ * auto obj = factory.create("!mytag"_tag);
+ * @endcode
+ */
+consteval Tag operator""_tag(const char * str, std::size_t size) { return Tag{{str, size}, TagHash({str, size})}; }
+
+}  // namespace literals
+
+/**
+ * @brief Insert-only open-addressing hash map with string tags as keys.
+ *
+ * Entries are stored in insertion order in segments that never move, and the hash index is a flat
+ * array of (fingerprint, entry index) slots that is probed linearly. Lookups take a
+ * std::string_view and do not allocate.
+ *
+ * Once all entries are inserted the map can be frozen, which replaces the probing index by a
+ * minimal perfect hash (hash and displace). A frozen lookup is two array reads followed by a
+ * single key comparison.
+ *
+ * Lookups are wait-free and may run concurrently with insert() and freeze(), which are serialized
+ * by a mutex. An insertion fills a free slot with a single atomic store; when the index must grow
+ * a new index is built on the side and published with an atomic pointer swap. Replaced indices are
+ * kept until the map is destroyed, since a concurrent reader may still be probing them. Geometric
+ * growth bounds their total size by that of the live index.
+ *
+ * @tparam T mapped type.
+ */
+template<typename T>
+class TagMap
+{
+public:
+  /// @brief Map entry.
+  struct Entry
+  {
+    std::string tag;
+    std::uint64_t hash;
+    T value;
+  };
+
+  TagMap()                           = default;
+  TagMap(const TagMap &)             = delete;
+  TagMap & operator=(const TagMap &) = delete;
+
+  /// @brief Move constructor, must not run concurrently with other operations on other.
+  TagMap(TagMap && other) noexcept { steal(other); }
+
+  /// @brief Move assignment, must not run concurrently with other operations on either map.
+  TagMap & operator=(TagMap && other) noexcept
+  {
+    if (this != &other) {
+      destroy();
+      steal(other);
+    }
+    return *this;
+  }
+
+  ~TagMap() { destroy(); }
+
+  /// @brief Index returned for missing tags.
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  /**
+   * @brief Insert a value.
+   *
+   * @return insertion index of the new entry, or npos if the tag is already present or the map is
+   * frozen, in which case the map is left unchanged.
+   */
+  std::size_t insert(std::string_view tag, T value)
+  {
+    std::lock_guard lock(m_mutex);
+
+    const auto hash = TagHash(tag);
+    if (m_frozen.load(std::memory_order_relaxed) || find_index(tag, hash) != npos) { return npos; }
+
+    const auto i = m_size.load(std::memory_order_relaxed);
+
+    // allocate everything that can throw before publishing anything
+    const auto * index = m_index.load(std::memory_order_relaxed);
+    std::unique_ptr<Index> grown;
+    if (index == nullptr || 2 * (i + 1) > index->slots.size()) {
+      grown = std::make_unique<Index>(index ? 2 * index->slots.size() : 8);
+      m_indices.reserve(m_indices.size() + 1);
+    }
+
+    const auto [s, offset] = locate(i);
+    auto * segment         = m_segments[s].load(std::memory_order_relaxed);
+    if (segment == nullptr) {
+      segment = std::allocator<Entry>{}.allocate(kSegment0 << s);
+      m_segments[s].store(segment, std::memory_order_release);
+    }
+    std::construct_at(segment + offset, Entry{std::string(tag), hash, std::move(value)});
+
+    if (grown) {
+      for (auto j = 0u; j <= i; ++j) { place(*grown, entry(j).hash, j); }
+      m_index.store(m_indices.emplace_back(std::move(grown)).get(), std::memory_order_release);
+    } else {
+      place(*m_indices.back(), hash, i);
+    }
+    m_size.store(i + 1, std::memory_order_release);
+    return i;
+  }
+
+  /**
+   * @brief Find the value for a tag.
+   *
+   * @return pointer to value, or nullptr if the tag is not present.
+   */
+  T * find(std::string_view tag) noexcept
+  {
+    const auto i = find_index(tag, TagHash(tag));
+    return i != npos ? &entry(i).value : nullptr;
+  }
+
+  /// @copydoc find
+  const T * find(std::string_view tag) const noexcept
+  {
+    const auto i = find_index(tag, TagHash(tag));
+    return i != npos ? &entry(i).value : nullptr;
+  }
+
+  /**
+   * @brief Find the insertion index for a tag with a known hash (see TagHash()).
+   *
+   * @return index, or npos if the tag is not present.
+   */
+  std::size_t find_index(std::string_view tag, std::uint64_t hash) const noexcept
+  {
+    if (const auto * perfect = m_perfect.load(std::memory_order_acquire)) {
+      const auto nbuckets = static_cast<std::uint32_t>(perfect->displacements.size());
+      const auto nentries = static_cast<std::uint32_t>(perfect->slots.size());
+      const auto d        = perfect->displacements[reduce(static_cast<std::uint32_t>(hash), nbuckets)];
+      const auto i        = perfect->slots[reduce(displace(hash, d), nentries)];
+      const auto & e      = entry(i);
+      return e.hash == hash && e.tag == tag ? i : npos;
+    }
+
+    const auto * index = m_index.load(std::memory_order_acquire);
+    if (index == nullptr) { return npos; }
+    const auto mask        = index->slots.size() - 1;
+    const auto fingerprint = hash >> 32;
+    for (auto i = home(*index, hash);; i = (i + 1) & mask) {
+      const auto slot = index->slots[i].load(std::memory_order_acquire);
+      if (slot == 0) { return npos; }
+      if ((slot >> 32) == fingerprint) {
+        const auto j   = static_cast<std::size_t>(slot & 0xffffffffu) - 1;
+        const auto & e = entry(j);
+        if (e.hash == hash && e.tag == tag) { return j; }
+      }
+    }
+  }
+
+  /// @brief Check if a tag is present.
+  bool contains(std::string_view tag) const noexcept { return find(tag) != nullptr; }
+
+  /// @brief Number of entries.
+  std::size_t size() const noexcept { return m_size.load(std::memory_order_acquire); }
+
+  /// @brief Access entry by insertion index (must be smaller than size()).
+  const Entry & operator[](std::size_t i) const noexcept { return entry(i); }
+
+  /**
+   * @brief Make the map immutable and build a perfect hash index.
+   *
+   * Subsequent calls have no effect.
+   */
+  void freeze()
+  {
+    std::lock_guard lock(m_mutex);
+    if (m_frozen.load(std::memory_order_relaxed)) { return; }
+    m_frozen.store(true, std::memory_order_release);
+
+    const auto n = static_cast<std::uint32_t>(m_size.load(std::memory_order_relaxed));
+    if (n == 0) { return; }
+    for (auto nbuckets = n / 4 + 1;; nbuckets = std::min(n, 2 * nbuckets)) {
+      if (auto perfect = build_perfect(nbuckets)) {
+        m_perfect.store(perfect.release(), std::memory_order_release);
+        return;
+      }
+      // only fails for colliding 64-bit hashes, in which case the probing index is kept
+      if (nbuckets == n) { return; }
+    }
+  }
+
+  /// @brief Check if the map is frozen.
+  bool frozen() const noexcept { return m_frozen.load(std::memory_order_acquire); }
+
+private:
+  static constexpr std::size_t kSegment0 = 16;
+  static constexpr std::size_t kSegments = 28;
+
+  /// @brief Probing index with slots (fingerprint << 32 | entry index + 1), where 0 marks a free slot.
+  struct Index
+  {
+    explicit Index(std::size_t capacity) : slots(capacity), shift(64 - std::countr_zero(capacity)) {}
+
+    std::vector<std::atomic<std::uint64_t>> slots;
+    int shift;
+  };
+
+  /// @brief Perfect index over the entries present when the map was frozen.
+  struct PerfectIndex
+  {
+    std::vector<std::uint32_t> displacements;
+    std::vector<std::uint32_t> slots;
+  };
+
+  /// @brief Segment and offset of an entry: segment s holds kSegment0 << s entries.
+  static std::pair<std::size_t, std::size_t> locate(std::size_t i) noexcept
+  {
+    const auto s = static_cast<std::size_t>(std::bit_width(i / kSegment0 + 1) - 1);
+    return {s, i - kSegment0 * ((std::size_t{1} << s) - 1)};
+  }
+
+  /// @brief Map 32 bits onto [0, n) without a division.
+  static std::uint32_t reduce(std::uint32_t x, std::uint32_t n) noexcept
+  {
+    return static_cast<std::uint32_t>((static_cast<std::uint64_t>(x) * n) >> 32);
+  }
+
+  /// @brief Displaced hash used by the perfect index.
+  static std::uint32_t displace(std::uint64_t hash, std::uint32_t d) noexcept
+  {
+    hash ^= d * 0x9e3779b97f4a7c15ull;
+    hash *= 0xbf58476d1ce4e5b9ull;
+    return static_cast<std::uint32_t>(hash >> 32);
+  }
+
+  static std::size_t home(const Index & index, std::uint64_t hash) noexcept
+  {
+    // fibonacci hashing spreads the weak low bits of FNV over the table
+    return static_cast<std::size_t>((hash * 0x9e3779b97f4a7c15ull) >> index.shift);
+  }
+
+  void destroy() noexcept
+  {
+    const auto n = m_size.load(std::memory_order_acquire);
+    for (auto i = 0u; i < n; ++i) { std::destroy_at(&entry(i)); }
+    for (auto s = 0u; s < kSegments; ++s) {
+      if (auto * segment = m_segments[s].load(std::memory_order_acquire)) {
+        std::allocator<Entry>{}.deallocate(segment, kSegment0 << s);
+      }
+    }
+    delete m_perfect.load(std::memory_order_acquire);
+  }
+
+  /// @brief Take over the contents of other and leave it empty.
+  void steal(TagMap & other) noexcept
+  {
+    for (auto s = 0u; s < kSegments; ++s) {
+      m_segments[s].store(other.m_segments[s].exchange(nullptr, std::memory_order_acq_rel), std::memory_order_release);
+    }
+    m_size.store(other.m_size.exchange(0, std::memory_order_acq_rel), std::memory_order_release);
+    m_index.store(other.m_index.exchange(nullptr, std::memory_order_acq_rel), std::memory_order_release);
+    m_indices = std::move(other.m_indices);
+    other.m_indices.clear();
+    m_frozen.store(other.m_frozen.exchange(false, std::memory_order_acq_rel), std::memory_order_release);
+    m_perfect.store(other.m_perfect.exchange(nullptr, std::memory_order_acq_rel), std::memory_order_release);
+  }
+
+  Entry & entry(std::size_t i) const noexcept
+  {
+    const auto [s, offset] = locate(i);
+    return m_segments[s].load(std::memory_order_acquire)[offset];
+  }
+
+  static void place(Index & index, std::uint64_t hash, std::size_t i) noexcept
+  {
+    const auto mask = index.slots.size() - 1;
+    auto k          = home(index, hash);
+    while (index.slots[k].load(std::memory_order_relaxed) != 0) { k = (k + 1) & mask; }
+    index.slots[k].store((hash >> 32) << 32 | (i + 1), std::memory_order_release);
+  }
+
+  std::unique_ptr<PerfectIndex> build_perfect(std::uint32_t nbuckets) const
+  {
+    static constexpr std::uint32_t kMaxDisplacement = 1u << 16;
+
+    const auto n = static_cast<std::uint32_t>(m_size.load(std::memory_order_relaxed));
+
+    std::vector<std::vector<std::uint32_t>> buckets(nbuckets);
+    for (auto i = 0u; i < n; ++i) {
+      buckets[reduce(static_cast<std::uint32_t>(entry(i).hash), nbuckets)].push_back(i);
+    }
+
+    // place large buckets first while there is plenty of room
+    std::vector<std::uint32_t> order(nbuckets);
+    for (auto b = 0u; b < nbuckets; ++b) { order[b] = b; }
+    std::stable_sort(order.begin(), order.end(), [&](auto b1, auto b2) {
+      return buckets[b1].size() > buckets[b2].size();
+    });
+
+    auto perfect = std::make_unique<PerfectIndex>();
+    perfect->displacements.assign(nbuckets, 0);
+    perfect->slots.assign(n, 0);
+    std::vector<bool> taken(n, false);
+    std::vector<std::uint32_t> positions;
+
+    for (const auto b : order) {
+      const auto & bucket = buckets[b];
+      if (bucket.empty()) { break; }
+
+      bool placed = false;
+      for (auto d = 0u; d < kMaxDisplacement && !placed; ++d) {
+        positions.clear();
+        placed = true;
+        for (const auto i : bucket) {
+          const auto pos = reduce(displace(entry(i).hash, d), n);
+          if (taken[pos] || std::find(positions.begin(), positions.end(), pos) != positions.end()) {
+            placed = false;
+            break;
+          }
+          positions.push_back(pos);
+        }
+        if (placed) {
+          perfect->displacements[b] = d;
+          for (auto k = 0u; k < bucket.size(); ++k) {
+            taken[positions[k]]          = true;
+            perfect->slots[positions[k]] = bucket[k];
+          }
+        }
+      }
+      if (!placed) { return nullptr; }
+    }
+
+    return perfect;
+  }
+
+  // entries
+  std::array<std::atomic<Entry *>, kSegments> m_segments{};
+  std::atomic<std::size_t> m_size{0};
+
+  // probing index, and all indices ever published
+  std::atomic<const Index *> m_index{nullptr};
+  std::vector<std::unique_ptr<Index>> m_indices;
+
+  // perfect index
+  std::atomic<bool> m_frozen{false};
+  std::atomic<const PerfectIndex *> m_perfect{nullptr};
+
+  // serializes writers
+  std::mutex m_mutex;
+};
+
+}  // namespace ezconfig
@@ -9,9 +9,17 @@
 
 #pragma once
 
+#include <filesystem>
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+
 #include <yaml-cpp/yaml.h>
 
 #include "factory.hpp"
+#include "mapped_file.hpp"
+#include "parallel.hpp"
 #include "yaml_fwd.hpp"
 
 /**
@@ -26,10 +34,12 @@
  * EZ_YAML_DEFINE(MyBase);
  * @endcode
  */
-#define EZ_YAML_DEFINE(Base)                                                 \
-  EZ_FACTORY_DEFINE(Base, const YAML::Node &);                               \
-  template std::unique_ptr<Base> ezconfig::yaml::Create(const YAML::Node &); \
-  template struct YAML::convert<std::shared_ptr<Base>>;                      \
+#define EZ_YAML_DEFINE(Base)                                                                                     \
+  EZ_FACTORY_DEFINE(Base, const YAML::Node &);                                                                   \
+  template std::unique_ptr<Base> ezconfig::yaml::Create(const YAML::Node &);                                     \
+  template ezconfig::PmrUniquePtr<Base> ezconfig::yaml::Create(const YAML::Node &, std::pmr::memory_resource *); \
+  template std::shared_ptr<Base> ezconfig::yaml::CreateShared(const YAML::Node &);                               \
+  template struct YAML::convert<std::shared_ptr<Base>>;                                                          \
   template struct YAML::convert<std::unique_ptr<Base>>
 
 /**
@@ -38,7 +48,7 @@
  * Do this in the implementation files for derived classes.
  *
  * @param Base factory base class.
- * @param tag conversion identifier (string).
+ * @param tag conversion identifier (constant string that starts with '!', checked at compile time).
  * @param Derived factory derived class.
  * @param Intermediate optional intermediate class.
  *
@@ -50,11 +60,19 @@
  * EZ_YAML_REGISTER(MyBase, "!mytag", MyDerived, MyDerivedConfig);
  * @endcode
  */
-#define EZ_YAML_REGISTER(Base, tag, Derived, ...) \
-  EZ_STATIC_INVOKE(&ezconfig::yaml::Add<Base, Derived __VA_OPT__(, ) __VA_ARGS__>, tag)
+#define EZ_YAML_REGISTER(Base, tag, Derived, ...)                                 \
+  static_assert(ezconfig::yaml::IsValidTag(tag), "yaml tag must start with !");   \
+  EZ_GLOBAL_REGISTER(                                                             \
+    ([] { ezconfig::yaml::Add<Base, Derived __VA_OPT__(, ) __VA_ARGS__>(tag); }), \
+    ezconfig::GeneralFactory<false, Base, const YAML::Node &>)
 
 namespace ezconfig::yaml {
 
+/**
+ * @brief Check if a yaml tag is valid, i.e. of the form "!tag".
+ */
+constexpr bool IsValidTag(std::string_view tag) noexcept { return tag.size() >= 2 && tag[0] == '!'; }
+
 // clang-format off
 template<typename T>
 concept YamlParseable = requires(const YAML::Node & y) {
@@ -62,6 +80,24 @@ concept YamlParseable = requires(const YAML::Node & y) {
 };
 // clang-format on
 
+/**
+ * @brief Decode a yaml-parseable type.
+ *
+ * Allocator-aware types (e.g. std::pmr containers) are constructed with the memory resource before
+ * decoding, so that their allocations are made from it.
+ */
+template<typename T>
+T DecodeWithResource(const YAML::Node & y, std::pmr::memory_resource * resource)
+{
+  if constexpr (std::uses_allocator_v<T, std::pmr::polymorphic_allocator<>>) {
+    auto obj = std::make_obj_using_allocator<T>(std::pmr::polymorphic_allocator<>(resource));
+    if (!YAML::convert<T>::decode(y, obj)) { throw YAML::TypedBadConversion<T>(y.Mark()); }
+    return obj;
+  } else {
+    return y.as<T>();
+  }
+}
+
 /**
  * @brief Add a factory method.
  *
@@ -79,11 +115,16 @@ template<typename Base, typename Derived, typename Intermediate = Derived>
   requires(
     std::is_base_of_v<Base, Derived> && YamlParseable<Intermediate>
     && std::is_constructible_v<Derived, Intermediate &&>)
-void Add(const std::string & tag)
+void Add(std::string_view tag)
 {
-  if (tag.size() < 2 || tag[0] != '!') { throw std::logic_error("yaml tag must start with !"); }
-  auto creator = [](const YAML::Node & y) { return std::make_unique<Derived>(y.as<Intermediate>()); };
-  EZ_FACTORY_INSTANCE(Base, const YAML::Node &).add(tag, std::move(creator));
+  if (!IsValidTag(tag)) { throw std::logic_error("yaml tag must start with !"); }
+  auto creator        = [](const YAML::Node & y) { return std::make_unique<Derived>(y.as<Intermediate>()); };
+  auto shared_creator = [](const YAML::Node & y) { return std::make_shared<Derived>(y.as<Intermediate>()); };
+  auto pmr_creator    = [](const YAML::Node & y, std::pmr::memory_resource * resource) {
+    return MakePmrUnique<Base, Derived>(resource, DecodeWithResource<Intermediate>(y, resource));
+  };
+  EZ_FACTORY_INSTANCE(Base, const YAML::Node &)
+    .add(tag, std::move(creator), std::move(shared_creator), std::move(pmr_creator));
 }
 
 template<typename Base>
@@ -92,12 +133,112 @@ std::unique_ptr<Base> Create(const YAML::Node & y)
   return EZ_FACTORY_INSTANCE(Base, const YAML::Node &).create(y.Tag(), y);
 }
 
+template<typename Base>
+PmrUniquePtr<Base> Create(const YAML::Node & y, std::pmr::memory_resource * resource)
+{
+  return EZ_FACTORY_INSTANCE(Base, const YAML::Node &).create_pmr(y.Tag(), resource, y);
+}
+
+template<typename Base>
+std::shared_ptr<Base> CreateShared(const YAML::Node & y)
+{
+  return EZ_FACTORY_INSTANCE(Base, const YAML::Node &).create_shared(y.Tag(), y);
+}
+
+/**
+ * @brief Create an object from a yaml file using the global factory.
+ *
+ * The file is memory mapped and parsed through a stream over the mapping, see MappedFile.
+ *
+ * @param path tagged yaml file
+ * @param stats optional output for file size and parse and construction times
+ *
+ * @code
+ * LoadStats stats;
+ * auto obj = yaml::LoadFile<MyBase>("config.yaml", &stats);
+ * @endcode
+ */
+template<typename Base>
+std::unique_ptr<Base> LoadFile(const std::filesystem::path & path, LoadStats * stats = nullptr)
+{
+  LoadStats s;
+  const MappedFile file(path);
+  ViewStreambuf buf(file.view());
+  std::istream is(&buf);
+  const auto y = ::ezconfig::detail::Timed(s.parse, [&] { return YAML::Load(is); });
+  auto ret     = ::ezconfig::detail::Timed(s.construct, [&] { return Create<Base>(y); });
+  if (stats != nullptr) {
+    s.bytes  = file.view().size();
+    s.mapped = file.mapped();
+    *stats   = s;
+  }
+  return ret;
+}
+
+/**
+ * @brief Create the objects in a yaml sequence in parallel.
+ *
+ * The objects are independent, so their (possibly slow) constructors can run concurrently. The
+ * output order is the sequence order. If creation fails the exception for the first failing element
+ * is rethrown.
+ *
+ * @param y yaml sequence of tagged objects.
+ * @param executor executor, e.g. a ThreadPool.
+ *
+ * @code
+ * ezconfig::ThreadPool pool;
+ * auto objs = yaml::CreateParallel<MyBase>(YAML::Load(data), pool);
+ * @endcode
+ */
+template<typename Base, Executor E>
+std::vector<std::unique_ptr<Base>> CreateParallel(const YAML::Node & y, E && executor)
+{
+  if (!y.IsSequence()) { throw YAML::ParserException(y.Mark(), "Expected sequence"); }
+
+  // nodes are looked up on the calling thread, tasks only touch their own subtree
+  const std::vector<YAML::Node> nodes(y.begin(), y.end());
+  std::vector<std::unique_ptr<Base>> ret(nodes.size());
+  ParallelFor(std::forward<E>(executor), nodes.size(), [&](std::size_t i) { ret[i] = Create<Base>(nodes[i]); });
+  return ret;
+}
+
+/**
+ * @brief Create the objects in a yaml map in parallel.
+ *
+ * @see CreateParallel()
+ *
+ * @param y yaml map from names to tagged objects.
+ * @param executor executor, e.g. a ThreadPool.
+ */
+template<typename Base, Executor E>
+std::map<std::string, std::unique_ptr<Base>> CreateMapParallel(const YAML::Node & y, E && executor)
+{
+  if (!y.IsMap()) { throw YAML::ParserException(y.Mark(), "Expected map"); }
+
+  std::vector<std::string> keys;
+  std::vector<YAML::Node> nodes;
+  for (const auto & node : y) {
+    keys.push_back(node.first.as<std::string>());
+    nodes.push_back(node.second);
+  }
+  std::vector<std::unique_ptr<Base>> objs(nodes.size());
+  ParallelFor(std::forward<E>(executor), nodes.size(), [&](std::size_t i) { objs[i] = Create<Base>(nodes[i]); });
+
+  std::map<std::string, std::unique_ptr<Base>> ret;
+  for (auto i = 0u; i < keys.size(); ++i) {
+    if (!ret.emplace(std::move(keys[i]), std::move(objs[i])).second) {
+      throw YAML::ParserException(y.Mark(), "Double key in map");
+    }
+  }
+  return ret;
+}
+
 }  // namespace ezconfig::yaml
 
 template<ezconfig::yaml::Constructible Base>
 bool YAML::convert<std::shared_ptr<Base>>::decode(const YAML::Node & y, std::shared_ptr<Base> & ptr)
 {
-  ptr = ::ezconfig::yaml::Create<Base>(y);
+  ptr = ::ezconfig::yaml::CreateShared<Base>(y);
   return true;
 }
 
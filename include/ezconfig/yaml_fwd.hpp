@@ -38,6 +38,38 @@ concept Constructible = ::ezconfig::Constructible<T, const YAML::Node &>;
 template<typename Base>
 std::unique_ptr<Base> Create(const YAML::Node & y);
 
+/**
+ * @brief Create an object from yaml in a memory resource using the global factory.
+ *
+ * The object is allocated from the memory resource. Allocator-aware objects (and intermediate
+ * types) are constructed with the memory resource, so that e.g. std::pmr container members are
+ * allocated from it as well.
+ *
+ * @tparam Base factory base class
+ *
+ * @param y yaml data
+ * @param resource memory resource (must outlive the object)
+ *
+ * @code
+ * ezconfig::Arena arena;
+ * auto obj = yaml::Create<MyBase>(YAML::Load(data), arena.resource());
+ * @endcode
+ */
+template<typename Base>
+PmrUniquePtr<Base> Create(const YAML::Node & y, std::pmr::memory_resource * resource);
+
+/**
+ * @brief Create a shared object from yaml using the global factory.
+ *
+ * The object and the shared pointer control block are allocated together.
+ *
+ * @tparam Base factory base class
+ *
+ * @param y yaml data
+ */
+template<typename Base>
+std::shared_ptr<Base> CreateShared(const YAML::Node & y);
+
 }  // namespace ezconfig::yaml
 
 /**
@@ -57,7 +89,7 @@ std::unique_ptr<Base> Create(const YAML::Node & y);
 #define EZ_YAML_DECLARE(Base) EZ_FACTORY_DECLARE(Base, const YAML::Node &)
 
 /**
- * @brief Converter yaml -> std::shared_ptr<Base> using yaml::Create().
+ * @brief Converter yaml -> std::shared_ptr<Base> using yaml::CreateShared().
  */
 template<ezconfig::yaml::Constructible Base>
 struct YAML::convert<std::shared_ptr<Base>>
@@ -0,0 +1,89 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file yaml_json.hpp
+ * @brief Conversion of yaml configs to json.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include <nlohmann/json.hpp>
+#include <yaml-cpp/yaml.h>
+
+#include "yaml.hpp"
+
+namespace ezconfig::yaml {
+
+namespace detail {
+
+/**
+ * @brief Convert a plain yaml scalar with the same rules as yaml-cpp.
+ *
+ * Booleans follow YAML::convert<bool>, so that e.g. "yes" and "on" are true like for the yaml
+ * backend.
+ */
+inline nlohmann::json ScalarToJson(const YAML::Node & y)
+{
+  const auto & str = y.Scalar();
+  if (y.Tag() == "!") { return str; }  // quoted
+  if (str.empty() || str == "~" || str == "null" || str == "Null" || str == "NULL") { return nullptr; }
+  if (bool b; YAML::convert<bool>::decode(y, b)) { return b; }
+  if (std::int64_t i; YAML::convert<std::int64_t>::decode(y, i)) { return i; }
+  if (std::uint64_t u; YAML::convert<std::uint64_t>::decode(y, u)) { return u; }
+  if (double d; YAML::convert<double>::decode(y, d)) { return d; }
+  return str;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Convert yaml data to json.
+ *
+ * Tagged nodes "!tag object" are converted to {"tag": object}, i.e. the json factory format, so
+ * that a config can be created from the result with json::Create() if the json tags are the yaml
+ * tags without the leading '!'. Plain scalars are converted to null, booleans, and numbers when
+ * yaml-cpp would decode them as such, and quoted scalars to strings.
+ *
+ * @note The conversion has no schema, so a string field with a plain value that looks like a boolean or
+ * a number, e.g. no, on, y, 1.10 or 007, becomes a json boolean or number. The yaml backend decodes
+ * such a field as a string, but json::Create() fails with a type error. Quote these values in yaml
+ * configs that are converted to json.
+ *
+ * @note yaml-cpp does not keep track of quotes on scalars with a custom tag, so !tag "123" becomes
+ * {"tag": 123}.
+ *
+ * @code
+ * // convert a yaml config to cbor
+ * const auto data = json::ToBinary(yaml::ToJson(YAML::LoadFile("config.yaml")), json::BinaryFormat::Cbor);
+ * @endcode
+ */
+inline nlohmann::json ToJson(const YAML::Node & y)
+{
+  nlohmann::json ret;
+  switch (y.Type()) {
+  case YAML::NodeType::Undefined:
+    throw std::logic_error("Can not convert undefined yaml node to json");
+  case YAML::NodeType::Null:
+    break;
+  case YAML::NodeType::Scalar:
+    ret = detail::ScalarToJson(y);
+    break;
+  case YAML::NodeType::Sequence:
+    ret = nlohmann::json::array();
+    for (const auto & x : y) { ret.push_back(ToJson(x)); }
+    break;
+  case YAML::NodeType::Map:
+    ret = nlohmann::json::object();
+    for (const auto & x : y) { ret[x.first.as<std::string>()] = ToJson(x.second); }
+    break;
+  }
+
+  if (IsValidTag(y.Tag())) { return {{y.Tag().substr(1), std::move(ret)}}; }
+  return ret;
+}
+
+}  // namespace ezconfig::yaml
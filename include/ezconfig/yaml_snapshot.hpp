@@ -0,0 +1,324 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file yaml_snapshot.hpp
+ * @brief Yaml factory with snapshots of decoded configs.
+ *
+ * Opt-in extension of yaml.hpp, see LoadFileCached(). Include this file instead of yaml.hpp in the
+ * implementation file for the base class and any derived classes, and declare the base class with
+ * EZ_YAML_SNAPSHOT_DECLARE() from yaml_snapshot_fwd.hpp.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <string>
+#include <typeinfo>
+
+#include <yaml-cpp/yaml.h>
+
+#include "mapped_file.hpp"
+#include "snapshot.hpp"
+#include "yaml.hpp"
+#include "yaml_snapshot_fwd.hpp"
+
+/**
+ * @brief Define a global yaml factory with snapshot support for a base class.
+ *
+ * Do this in the base class implementation file instead of EZ_YAML_DEFINE().
+ *
+ * @param Base factory base class.
+ *
+ * Example: Define a \a MyBase yaml factory with snapshots.
+ * @code
+ * EZ_YAML_SNAPSHOT_DEFINE(MyBase);
+ * @endcode
+ */
+#define EZ_YAML_SNAPSHOT_DEFINE(Base) \
+  EZ_YAML_DEFINE(Base);               \
+  EZ_FACTORY_DEFINE(ezconfig::yaml::SnapshotLoader<Base>)
+
+/**
+ * @brief Register a conversion method that supports snapshots with the global yaml factory.
+ *
+ * Like EZ_YAML_REGISTER(), but the intermediate type must also be Serializable.
+ *
+ * Example: Register a creator for \a MyDerived with tag "!mytag".
+ * @code
+ * EZ_YAML_SNAPSHOT_REGISTER(MyBase, "!mytag", MyDerived, MyDerivedConfig);
+ * @endcode
+ */
+#define EZ_YAML_SNAPSHOT_REGISTER(Base, tag, Derived, ...)                                \
+  static_assert(ezconfig::yaml::IsValidTag(tag), "yaml tag must start with !");           \
+  EZ_GLOBAL_REGISTER(                                                                     \
+    ([] { ezconfig::yaml::AddSnapshot<Base, Derived __VA_OPT__(, ) __VA_ARGS__>(tag); }), \
+    ezconfig::GeneralFactory<false, Base, const YAML::Node &>)
+
+namespace ezconfig::yaml {
+
+/**
+ * @brief Creator of objects from snapshots, see LoadFileCached().
+ *
+ * Loaders are created by a global factory per base class, and are registered by AddSnapshot().
+ */
+template<typename Base>
+class SnapshotLoader
+{
+public:
+  virtual ~SnapshotLoader() = default;
+
+  /// @brief Schema hash of the intermediate type.
+  virtual std::uint64_t schema() const = 0;
+
+  /// @brief Create an object from its serialized intermediate.
+  virtual std::unique_ptr<Base> create(SnapshotReader & r) const = 0;
+
+  /// @brief Create a shared object from its serialized intermediate.
+  virtual std::shared_ptr<Base> create_shared(SnapshotReader & r) const = 0;
+};
+
+/**
+ * @brief Creator of Derived from a serialized Intermediate.
+ */
+template<typename Base, typename Derived, typename Intermediate>
+class SnapshotCreator : public SnapshotLoader<Base>
+{
+public:
+  std::uint64_t schema() const override { return SchemaHash<Intermediate>(); }
+
+  std::unique_ptr<Base> create(SnapshotReader & r) const override
+  {
+    return std::make_unique<Derived>(r.read<Intermediate>());
+  }
+
+  std::shared_ptr<Base> create_shared(SnapshotReader & r) const override
+  {
+    return std::make_shared<Derived>(r.read<Intermediate>());
+  }
+};
+
+namespace detail {
+
+/**
+ * @brief Decode Intermediate and make an object from it.
+ *
+ * If a SnapshotRecorder is active the serialized intermediate is recorded for the object, unless
+ * it contains objects that were not recorded.
+ */
+template<typename Base, typename Intermediate, typename Make>
+auto DecodeAndMake(const YAML::Node & y, Make && make)
+{
+  auto obj        = y.as<Intermediate>();
+  auto * recorder = SnapshotRecorder::active();
+  if (recorder == nullptr) { return std::forward<Make>(make)(std::move(obj)); }
+
+  SnapshotWriter w;
+  bool complete = true;
+  try {
+    w.write_string(y.Tag());
+    w.write(SchemaHash<Intermediate>());
+    w.write(obj);
+  } catch (const SnapshotError &) {
+    complete = false;
+  }
+  auto ret = std::forward<Make>(make)(std::move(obj));
+  if (complete) { recorder->record(static_cast<const Base *>(ret.get()), std::move(w).data()); }
+  return ret;
+}
+
+/// @brief Read a snapshot of an object written by Serializer<std::unique_ptr<Base>>.
+template<typename Base, typename F>
+auto ReadSnapshot(SnapshotReader & r, F && f) -> decltype(f(std::declval<const SnapshotLoader<Base> &>()))
+{
+  const auto tag = r.read_string();
+  if (tag.empty()) { return nullptr; }
+  const auto schema = r.read<std::uint64_t>();
+  EZ_FACTORY_INSTANCE(Base, const YAML::Node &);  // run registrations
+  const auto loader = EZ_FACTORY_INSTANCE(SnapshotLoader<Base>).create(tag);
+  if (loader->schema() != schema) {
+    throw std::runtime_error("Snapshot schema for tag '" + std::string(tag) + "' has changed");
+  }
+  return std::forward<F>(f)(*loader);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Add a factory method that supports snapshots.
+ *
+ * Like Add(), and in addition registers a SnapshotLoader for the tag. Objects created while a
+ * SnapshotRecorder is active on the thread are recorded, see LoadFileCached().
+ *
+ * @tparam Derived sub-class of Base.
+ * @tparam Intermediate type that is parseable from yaml and Serializable, and that can construct Derived.
+ *
+ * @note The Serializer specialization must be visible where the tag is registered.
+ */
+template<typename Base, typename Derived, typename Intermediate = Derived>
+  requires(
+    std::is_base_of_v<Base, Derived> && YamlParseable<Intermediate> && Serializable<Intermediate>
+    && std::is_constructible_v<Derived, Intermediate &&>)
+void AddSnapshot(std::string_view tag)
+{
+  if (!IsValidTag(tag)) { throw std::logic_error("yaml tag must start with !"); }
+  auto creator = [](const YAML::Node & y) {
+    return detail::DecodeAndMake<Base, Intermediate>(y, [](Intermediate && i) {
+      return std::make_unique<Derived>(std::move(i));
+    });
+  };
+  auto shared_creator = [](const YAML::Node & y) {
+    return detail::DecodeAndMake<Base, Intermediate>(y, [](Intermediate && i) {
+      return std::make_shared<Derived>(std::move(i));
+    });
+  };
+  auto pmr_creator = [](const YAML::Node & y, std::pmr::memory_resource * resource) {
+    return MakePmrUnique<Base, Derived>(resource, DecodeWithResource<Intermediate>(y, resource));
+  };
+  EZ_FACTORY_INSTANCE(Base, const YAML::Node &)
+    .add(tag, std::move(creator), std::move(shared_creator), std::move(pmr_creator));
+  EZ_FACTORY_INSTANCE(SnapshotLoader<Base>).add(tag, [] {
+    return std::make_unique<SnapshotCreator<Base, Derived, Intermediate>>();
+  });
+}
+
+/**
+ * @brief Create an object from a yaml file, using a snapshot if the file has not changed.
+ *
+ * The first load parses the file as LoadFile() does, and records the decoded intermediate types of
+ * all created objects in a snapshot file. Later loads of the same file create the objects directly
+ * from the memory mapped snapshot without parsing any yaml.
+ *
+ * The snapshot is keyed by a hash of the file contents, and each object in it by the schema hash of
+ * its intermediate type (see SchemaHash()). The snapshot data is protected by a checksum. If the
+ * file or a schema changed, or if the snapshot can not be read, the file is parsed and the snapshot
+ * rewritten.
+ *
+ * Snapshots require that all created objects are registered with AddSnapshot() and are created on
+ * the calling thread. Otherwise no snapshot is written, and every load parses the file.
+ *
+ * @param path tagged yaml file
+ * @param snapshot_path snapshot file
+ * @param stats optional output for file size and parse and construction times
+ *
+ * @code
+ * LoadStats stats;
+ * auto obj = yaml::LoadFileCached<MyBase>("config.yaml", "/tmp/config.snapshot", &stats);
+ * assert(stats.snapshot);  // on the second run
+ * @endcode
+ */
+template<typename Base>
+std::unique_ptr<Base> LoadFileCached(
+  const std::filesystem::path & path, const std::filesystem::path & snapshot_path, LoadStats * stats = nullptr)
+{
+  LoadStats s;
+  const MappedFile file(path);
+  const auto source = file.view();
+
+  SnapshotWriter header;
+  header.write_bytes("ezsnap02", 8);
+  header.write(HashBytes(source));
+  header.write(static_cast<std::uint64_t>(source.size()));
+  header.write(HashBytes(typeid(Base).name()));
+
+  std::unique_ptr<Base> ret;
+  if (std::error_code ec; std::filesystem::is_regular_file(snapshot_path, ec)) {
+    try {
+      const MappedFile snapshot(snapshot_path);
+      SnapshotReader r(snapshot.view());
+      // the payload checksum detects files that were corrupted or written concurrently
+      if (r.read_bytes(header.data().size()) == header.data()) {
+        const auto checksum = r.read<std::uint64_t>();
+        const auto payload  = snapshot.view().substr(header.data().size() + sizeof(checksum));
+        if (HashBytes(payload) == checksum) {
+          SnapshotReader pr(payload);
+          ret = ::ezconfig::detail::Timed(s.construct, [&] { return pr.read<std::unique_ptr<Base>>(); });
+          s.snapshot = ret != nullptr && pr.at_end();
+        }
+      }
+    } catch (const std::exception &) {
+      s.snapshot = false;
+    }
+  }
+
+  if (!s.snapshot) {
+    ret.reset();
+    s.construct = {};
+
+    SnapshotRecorder recorder;
+    ViewStreambuf buf(source);
+    std::istream is(&buf);
+    const auto y = ::ezconfig::detail::Timed(s.parse, [&] { return YAML::Load(is); });
+    ret          = ::ezconfig::detail::Timed(s.construct, [&] { return Create<Base>(y); });
+
+    // the snapshot is best effort, objects that can not be serialized are detected here
+    try {
+      SnapshotWriter payload;
+      payload.write(ret);
+      auto w = std::move(header);
+      w.write(HashBytes(payload.data()));
+      w.write_bytes(payload.data().data(), payload.data().size());
+      WriteSnapshotFile(snapshot_path, w.data());
+    } catch (const std::exception &) {
+    }
+  }
+
+  if (stats != nullptr) {
+    s.bytes  = source.size();
+    s.mapped = file.mapped();
+    *stats   = s;
+  }
+  return ret;
+}
+
+}  // namespace ezconfig::yaml
+
+/**
+ * @brief Serializer for std::unique_ptr<Base> of objects created while a SnapshotRecorder is active.
+ *
+ * The recorded snapshot of the object is moved into the output, so that each object is held once
+ * by the recorder.
+ */
+template<ezconfig::yaml::Constructible Base>
+struct ezconfig::Serializer<std::unique_ptr<Base>>
+{
+  static void write(SnapshotWriter & w, const std::unique_ptr<Base> & obj)
+  {
+    if (!obj) { return w.write_string(""); }
+    auto * recorder = SnapshotRecorder::active();
+    if (recorder == nullptr) { throw SnapshotError("No active snapshot recorder"); }
+    const auto data = recorder->take(obj.get());
+    w.write_bytes(data.data(), data.size());
+  }
+
+  static std::unique_ptr<Base> read(SnapshotReader & r)
+  {
+    return yaml::detail::ReadSnapshot<Base>(
+      r, [&](const yaml::SnapshotLoader<Base> & loader) { return loader.create(r); });
+  }
+};
+
+/**
+ * @brief Serializer for std::shared_ptr<Base> of objects created while a SnapshotRecorder is active.
+ *
+ * The recorded snapshot is copied since the object may be shared.
+ */
+template<ezconfig::yaml::Constructible Base>
+struct ezconfig::Serializer<std::shared_ptr<Base>>
+{
+  static void write(SnapshotWriter & w, const std::shared_ptr<Base> & obj)
+  {
+    if (!obj) { return w.write_string(""); }
+    auto * recorder = SnapshotRecorder::active();
+    if (recorder == nullptr) { throw SnapshotError("No active snapshot recorder"); }
+    const auto & data = recorder->find(obj.get());
+    w.write_bytes(data.data(), data.size());
+  }
+
+  static std::shared_ptr<Base> read(SnapshotReader & r)
+  {
+    return yaml::detail::ReadSnapshot<Base>(
+      r, [&](const yaml::SnapshotLoader<Base> & loader) { return loader.create_shared(r); });
+  }
+};
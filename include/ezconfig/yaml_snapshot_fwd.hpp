@@ -0,0 +1,35 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file yaml_snapshot_fwd.hpp
+ * @brief Yaml factory with snapshots forward declarations.
+ *
+ * Include this file in the header for the base class instead of yaml_fwd.hpp.
+ */
+
+#pragma once
+
+#include "yaml_fwd.hpp"
+
+namespace ezconfig::yaml {
+
+template<typename Base>
+class SnapshotLoader;
+
+}  // namespace ezconfig::yaml
+
+/**
+ * @brief Declare a global yaml factory with snapshot support for a base class.
+ *
+ * Do this in the base class header file instead of EZ_YAML_DECLARE().
+ *
+ * @param Base factory base class.
+ *
+ * Example: Declare a \a MyBase yaml factory with snapshots.
+ * @code
+ * EZ_YAML_SNAPSHOT_DECLARE(MyBase);
+ * @endcode
+ */
+#define EZ_YAML_SNAPSHOT_DECLARE(Base) \
+  EZ_YAML_DECLARE(Base);               \
+  EZ_FACTORY_DECLARE(ezconfig::yaml::SnapshotLoader<Base>)
@@ -0,0 +1,128 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file decode.hpp
+ * @brief Fast decoding of numbers and of the containers that yaml-cpp converts.
+ *
+ * yaml-cpp already defines YAML::convert for std::vector, std::map, std::array and std::pair,
+ * so those conversions can not be replaced. ezconfig::yaml::As() decodes them with the
+ * containers sized up front, each key converted once, and elements moved into place, and
+ * the converters in yaml_types decode their members through it.
+ */
+
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <yaml-cpp/yaml.h>
+
+#include "number.hpp"
+
+namespace ezconfig::yaml {
+
+namespace detail {
+
+template<typename T>
+struct is_std_vector : std::false_type
+{};
+
+template<typename T, typename A>
+struct is_std_vector<std::vector<T, A>> : std::true_type
+{};
+
+/**
+ * @brief Decoder of a std::vector that As() uses instead of decoding element by element.
+ *
+ * Specializations have a static bool decode(const YAML::Node &, Vector &), which returns false if
+ * the node can not be decoded in bulk. They must be declared together with the YAML::convert of
+ * the element type, so that every translation unit that decodes the vector sees them.
+ */
+template<typename Vector>
+struct VectorDecoder
+{};
+
+// clang-format off
+template<typename T>
+concept HasVectorDecoder = requires(const YAML::Node & yaml, T & obj) {
+  { VectorDecoder<T>::decode(yaml, obj) } -> std::same_as<bool>;
+};
+// clang-format on
+
+template<typename T>
+struct is_std_map : std::false_type
+{};
+
+template<typename K, typename V, typename C, typename A>
+struct is_std_map<std::map<K, V, C, A>> : std::true_type
+{};
+
+template<typename T>
+struct is_std_array : std::false_type
+{};
+
+template<typename T, std::size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type
+{};
+
+template<typename T>
+struct is_std_pair : std::false_type
+{};
+
+template<typename T, typename U>
+struct is_std_pair<std::pair<T, U>> : std::true_type
+{};
+
+}  // namespace detail
+
+/**
+ * @brief Decode a yaml node with fast paths for numbers and standard containers.
+ *
+ * Equivalent to yaml.as<T>(), which is used for other types and for nodes that the fast
+ * paths do not handle, so that errors are reported by yaml-cpp as usual.
+ */
+template<typename T>
+T As(const YAML::Node & yaml)
+{
+  if constexpr (FastNumber<T>) {
+    if (yaml.IsScalar()) {
+      if (const auto v = ParseNumber<T>(yaml.Scalar())) { return *v; }
+    }
+  } else if constexpr (detail::HasVectorDecoder<T>) {
+    if (T ret; detail::VectorDecoder<T>::decode(yaml, ret)) { return ret; }
+  } else if constexpr (detail::is_std_vector<T>::value) {
+    if (yaml.IsSequence()) {
+      T ret;
+      ret.reserve(yaml.size());
+      for (const auto & item : yaml) { ret.push_back(As<typename T::value_type>(item)); }
+      return ret;
+    }
+  } else if constexpr (detail::is_std_map<T>::value) {
+    if (yaml.IsMap()) {
+      // the last occurrence of a key is used like in YAML::convert<std::map>
+      T ret;
+      for (const auto & kv : yaml) {
+        ret.insert_or_assign(ret.end(), As<typename T::key_type>(kv.first), As<typename T::mapped_type>(kv.second));
+      }
+      return ret;
+    }
+  } else if constexpr (detail::is_std_array<T>::value) {
+    if (yaml.IsSequence() && yaml.size() == std::tuple_size_v<T>) {
+      T ret;
+      for (std::size_t i = 0; const auto & item : yaml) { ret[i++] = As<typename T::value_type>(item); }
+      return ret;
+    }
+  } else if constexpr (detail::is_std_pair<T>::value) {
+    if (yaml.IsSequence() && yaml.size() == 2) {
+      return T(As<typename T::first_type>(yaml[0]), As<typename T::second_type>(yaml[1]));
+    }
+  }
+  return yaml.template as<T>();
+}
+
+}  // namespace ezconfig::yaml
@@ -2,8 +2,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <string>
+
 #include <yaml-cpp/yaml.h>
 
+#include "decode.hpp"
 #include "eigen_fwd.hpp"
 
 namespace YAML {
@@ -20,32 +24,44 @@ bool convert<Eigen::Matrix<T, Rows, Cols, Opts>>::decode(const Node & yaml, Eige
             + std::to_string(yaml.size()) + "'",
         };
       }
-      // compile-time vector
-      const auto data = yaml.as<std::vector<T>>();
-      obj = Eigen::Map<const Eigen::Matrix<T, Rows, Cols>>(data.data(), static_cast<Eigen::Index>(data.size()));
+      obj.resize(static_cast<Eigen::Index>(yaml.size()));
+      for (Eigen::Index i = 0; const auto & item : yaml) { obj(i++) = ::ezconfig::yaml::As<T>(item); }
     } else if (yaml.IsMap()) {
       // count x,y,z keys
       auto counter = [](const auto & item) {
-        const auto k = item.first.template as<std::string>();
+        const auto & k = item.first.Scalar();
         return k == "x" || k == "y" || k == "z";
       };
       Eigen::Index N = std::count_if(std::begin(yaml), std::end(yaml), counter);
       obj.resize(N);
-      for (auto i = 0u; i < N; ++i) { obj(i) = yaml[char('x' + i)].as<T>(); }
+      for (auto i = 0u; i < N; ++i) { obj(i) = ::ezconfig::yaml::As<T>(yaml[char('x' + i)]); }
     } else {
       throw YAML::ParserException{yaml.Mark(), "Expected sequence or map"};
     }
   } else {
-    // compile-time matrix
-    const auto data = yaml.as<std::vector<std::vector<T>>>();
-    if (data.empty()) { throw YAML::ParserException{yaml.Mark(), "Can not parse empty matrix"}; }
-    obj.resize(static_cast<Eigen::Index>(data.size()), static_cast<Eigen::Index>(data[0].size()));
-    for (auto i = 0u; const auto & data_row : data) {
-      if (static_cast<Eigen::Index>(data_row.size()) != obj.cols()) {
-        throw YAML::ParserException{yaml.Mark(), "Not all rows have the same length"};
+    if (!yaml.IsSequence() || yaml.size() == 0) {
+      throw YAML::ParserException{yaml.Mark(), "Can not parse empty matrix"};
+    }
+    const auto first = *yaml.begin();
+    if (!first.IsSequence()) { throw YAML::ParserException{first.Mark(), "Expected sequence"}; }
+
+    const auto rows = static_cast<Eigen::Index>(yaml.size());
+    const auto cols = static_cast<Eigen::Index>(first.size());
+    if ((Rows > 0 && rows != Rows) || (Cols > 0 && cols != Cols)) {
+      throw YAML::ParserException{
+        yaml.Mark(),
+        "Invalid size of numeric yaml matrix: expected '" + std::to_string(Rows) + "x" + std::to_string(Cols)
+          + "' but got '" + std::to_string(rows) + "x" + std::to_string(cols) + "'",
+      };
+    }
+    obj.resize(rows, cols);
+
+    for (Eigen::Index i = 0; const auto & row : yaml) {
+      if (!row.IsSequence() || static_cast<Eigen::Index>(row.size()) != cols) {
+        throw YAML::ParserException{row.Mark(), "Not all rows have the same length"};
       }
-      obj.row(i++) =
-        Eigen::Map<const Eigen::Matrix<T, Cols, 1>>(data_row.data(), static_cast<Eigen::Index>(data_row.size()));
+      for (Eigen::Index j = 0; const auto & item : row) { obj(i, j++) = ::ezconfig::yaml::As<T>(item); }
+      ++i;
     }
   }
   return true;
@@ -55,15 +71,15 @@ template<typename T, int Opts>
 bool convert<Eigen::Quaternion<T, Opts>>::decode(const Node & yaml, Eigen::Quaternion<T, Opts> & obj)
 {
   if (yaml["w"]) {
-    obj.w() = yaml["w"].as<T>();
-    obj.x() = yaml["x"].as<T>();
-    obj.y() = yaml["y"].as<T>();
-    obj.z() = yaml["z"].as<T>();
+    obj.w() = ::ezconfig::yaml::As<T>(yaml["w"]);
+    obj.x() = ::ezconfig::yaml::As<T>(yaml["x"]);
+    obj.y() = ::ezconfig::yaml::As<T>(yaml["y"]);
+    obj.z() = ::ezconfig::yaml::As<T>(yaml["z"]);
   } else if (yaml["qw"]) {
-    obj.w() = yaml["qw"].as<T>();
-    obj.x() = yaml["qx"].as<T>();
-    obj.y() = yaml["qy"].as<T>();
-    obj.z() = yaml["qz"].as<T>();
+    obj.w() = ::ezconfig::yaml::As<T>(yaml["qw"]);
+    obj.x() = ::ezconfig::yaml::As<T>(yaml["qx"]);
+    obj.y() = ::ezconfig::yaml::As<T>(yaml["qy"]);
+    obj.z() = ::ezconfig::yaml::As<T>(yaml["qz"]);
   } else {
     throw YAML::ParserException{yaml.Mark(), "Expected key 'w' or 'qw'"};
   }
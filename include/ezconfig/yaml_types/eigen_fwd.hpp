@@ -14,11 +14,14 @@ struct convert;
 class Node;
 
 /**
- * @brief Decode a fixed-size Eigen vector from yaml.
+ * @brief Decode an Eigen vector or matrix from yaml.
  *
  * The YAML representation is a list, e.g. "[1, 2, 3]",
  * or, for vectors of size at most 3, a dictionary like
- * "{x: 1, y: 2, z: 3}".
+ * "{x: 1, y: 2, z: 3}". Matrices are lists of rows.
+ *
+ * Elements are decoded directly into the matrix without
+ * intermediate containers.
  */
 template<typename T, int Rows, int Cols, int Opts>
 struct convert<Eigen::Matrix<T, Rows, Cols, Opts>>
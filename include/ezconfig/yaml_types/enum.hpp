@@ -2,18 +2,34 @@
 
 #pragma once
 
-#include <magic_enum/magic_enum.hpp>
+#include <string>
+#include <type_traits>
+
 #include <yaml-cpp/yaml.h>
 
 #include "enum_fwd.hpp"
+#include "enum_table.hpp"
+
+template<ezconfig::ScopedEnum T>
+YAML::Node YAML::convert<T>::encode(const T & obj)
+{
+  if (const auto name = ezconfig::detail::EnumTable<T>::name(obj); !name.empty()) { return Node(std::string(name)); }
+  return Node(static_cast<std::underlying_type_t<T>>(obj));
+}
 
 template<ezconfig::ScopedEnum T>
 bool YAML::convert<T>::decode(const Node & yaml, T & obj)
 {
-  auto maybe_val = magic_enum::enum_cast<T>(yaml.as<std::string>());
+  if (!yaml.IsScalar()) { return false; }
+  const auto maybe_val = ezconfig::detail::EnumTable<T>::find(yaml.Scalar());
   if (maybe_val.has_value()) {
     obj = maybe_val.value();
     return true;
   }
+  // values without a name are encoded as integers
+  if (std::underlying_type_t<T> val; convert<std::underlying_type_t<T>>::decode(yaml, val)) {
+    obj = static_cast<T>(val);
+    return true;
+  }
   return false;
 }
@@ -9,6 +9,20 @@ namespace ezconfig {
 template<typename T>
 concept ScopedEnum = requires { std::is_enum_v<T> && !std::is_convertible_v<T, std::underlying_type_t<T>>; };
 
+/**
+ * @brief Type trait to match enum names without regard to (ASCII) case when decoding.
+ *
+ * Example:
+ * @code
+ * template<>
+ * struct ezconfig::enum_case_insensitive<MyEnum> : std::true_type
+ * {};
+ * @endcode
+ */
+template<typename T>
+struct enum_case_insensitive : std::false_type
+{};
+
 }  // namespace ezconfig
 
 namespace YAML {
@@ -20,11 +34,16 @@ struct convert;
 class Node;
 
 /**
- * @brief Decode an enum from yaml.
+ * @brief Decode and encode an enum as the name of its value.
+ *
+ * Names are matched exactly unless @ref ezconfig::enum_case_insensitive is specialized for T.
+ * Values without a name are encoded as their underlying integer, which is also accepted when
+ * decoding.
  */
 template<ezconfig::ScopedEnum T>
 struct convert<T>
 {
+  static Node encode(const T & obj);
   static bool decode(const Node & yaml, T & obj);
 };
 
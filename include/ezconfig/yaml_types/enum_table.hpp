@@ -0,0 +1,110 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include <magic_enum/magic_enum.hpp>
+
+#include "../meta.hpp"
+#include "enum_fwd.hpp"
+
+namespace ezconfig::detail {
+
+constexpr char AsciiToLower(char c) noexcept { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; }
+
+/**
+ * @brief Compile-time name table of an enum.
+ *
+ * The enumerator names reported by magic_enum are placed in a StaticStringTable, so that a name is
+ * matched to its value with one hash and (usually) one string comparison. If
+ * ezconfig::enum_case_insensitive is specialized for T the table holds lower-case names, and
+ * lookups lower-case the name in a stack buffer first.
+ */
+template<ScopedEnum T>
+struct EnumTable
+{
+  static constexpr auto kValues = magic_enum::enum_values<T>();
+  static constexpr auto kNames  = magic_enum::enum_names<T>();
+
+  /// @brief Number of enumerators.
+  static constexpr std::size_t kSize = kValues.size();
+
+  static constexpr bool kCaseInsensitive = enum_case_insensitive<T>::value;
+
+  /// @brief Length of the longest name.
+  static constexpr std::size_t kMaxLength = [] {
+    std::size_t ret = 0;
+    for (const auto name : kNames) { ret = name.size() > ret ? name.size() : ret; }
+    return ret;
+  }();
+
+  /// @brief Lower-case names stored back to back (empty if matching is case sensitive).
+  static constexpr auto kFolded = [] {
+    constexpr std::size_t kLength = [] {
+      std::size_t ret = 0;
+      if constexpr (kCaseInsensitive) {
+        for (const auto name : kNames) { ret += name.size(); }
+      }
+      return ret;
+    }();
+    std::array<char, kLength> ret{};
+    if constexpr (kCaseInsensitive) {
+      for (std::size_t pos = 0; const auto name : kNames) {
+        for (const char c : name) { ret[pos++] = AsciiToLower(c); }
+      }
+    }
+    return ret;
+  }();
+
+  /// @brief Names as matched by find().
+  static constexpr StaticStringTable<kSize> kKeys = [] {
+    std::array<std::string_view, kSize> keys = kNames;
+    if constexpr (kCaseInsensitive) {
+      for (std::size_t i = 0, pos = 0; i < kSize; pos += kNames[i++].size()) {
+        keys[i] = std::string_view(kFolded.data() + pos, kNames[i].size());
+      }
+    }
+    return StaticStringTable<kSize>(keys);
+  }();
+
+  static_assert(
+    [] {
+      for (auto i = 0u; i < kSize; ++i) {
+        for (auto j = i + 1; j < kSize; ++j) {
+          if (kKeys[i] == kKeys[j]) { return false; }
+        }
+      }
+      return true;
+    }(),
+    "enum_case_insensitive enum names must be unique when compared without case");
+
+  /// @brief Value of the enumerator with a name, or std::nullopt if there is none.
+  static constexpr std::optional<T> find(std::string_view name) noexcept
+  {
+    if constexpr (kCaseInsensitive) {
+      if (name.size() > kMaxLength) { return std::nullopt; }
+      std::array<char, kMaxLength> buf{};
+      for (auto i = 0u; i < name.size(); ++i) { buf[i] = AsciiToLower(name[i]); }
+      return find_key(std::string_view(buf.data(), name.size()));
+    } else {
+      return find_key(name);
+    }
+  }
+
+  /// @brief Name of an enumerator, or an empty string if the value has no name.
+  static constexpr std::string_view name(T value) noexcept { return magic_enum::enum_name(value); }
+
+private:
+  static constexpr std::optional<T> find_key(std::string_view key) noexcept
+  {
+    if (const auto i = kKeys.find(key); i < kSize) { return kValues[i]; }
+    return std::nullopt;
+  }
+};
+
+}  // namespace ezconfig::detail
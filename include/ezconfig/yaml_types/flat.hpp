@@ -0,0 +1,122 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+
+#include <yaml-cpp/yaml.h>
+
+#include "decode.hpp"
+#include "flat_fwd.hpp"
+
+namespace ezconfig::yaml::detail {
+
+/**
+ * @brief Find the first node in yaml whose key is equivalent to a previous one.
+ *
+ * Only called to report errors, so the keys are decoded again.
+ */
+template<typename K, typename C, typename KeyOf>
+YAML::Node FindDuplicate(const YAML::Node & yaml, const K & key, const C & comp, KeyOf && key_of)
+{
+  bool seen = false;
+  for (const auto & item : yaml) {
+    const auto node = key_of(item);
+    const auto k    = As<K>(node);
+    if (!comp(k, key) && !comp(key, k)) {
+      if (seen) { return node; }
+      seen = true;
+    }
+  }
+  return yaml;
+}
+
+}  // namespace ezconfig::yaml::detail
+
+namespace YAML {
+
+template<typename K, typename V, typename C>
+bool convert<ezconfig::FlatMap<K, V, C>>::decode(const Node & yaml, ezconfig::FlatMap<K, V, C> & obj)
+{
+  if (!yaml.IsMap()) { return false; }
+
+  typename ezconfig::FlatMap<K, V, C>::container_type data;
+  data.reserve(yaml.size());
+  for (const auto & kv : yaml) {
+    data.emplace_back(::ezconfig::yaml::As<K>(kv.first), ::ezconfig::yaml::As<V>(kv.second));
+  }
+
+  const C comp{};
+  const auto less = [&](const auto & a, const auto & b) { return comp(a.first, b.first); };
+  std::stable_sort(data.begin(), data.end(), less);
+  const auto dup = std::adjacent_find(data.begin(), data.end(), std::not_fn(less));
+  if (dup != data.end()) {
+    const auto node =
+      ::ezconfig::yaml::detail::FindDuplicate(yaml, dup->first, comp, [](const auto & kv) -> Node { return kv.first; });
+    throw YAML::ParserException(node.Mark(), "Double key '" + node.Scalar() + "' in map");
+  }
+
+  obj = ezconfig::FlatMap<K, V, C>(ezconfig::sorted_unique, std::move(data), comp);
+  return true;
+}
+
+template<typename K, typename V, typename C>
+Node convert<ezconfig::FlatMap<K, V, C>>::encode(const ezconfig::FlatMap<K, V, C> & obj)
+{
+  Node node(NodeType::Map);
+  for (const auto & [key, val] : obj) { node.force_insert(key, val); }
+  return node;
+}
+
+template<typename T, typename C>
+bool convert<ezconfig::FlatSet<T, C>>::decode(const Node & yaml, ezconfig::FlatSet<T, C> & obj)
+{
+  if (!yaml.IsSequence()) { return false; }
+
+  typename ezconfig::FlatSet<T, C>::container_type data;
+  data.reserve(yaml.size());
+  for (const auto & item : yaml) { data.push_back(::ezconfig::yaml::As<T>(item)); }
+
+  const C comp{};
+  std::stable_sort(data.begin(), data.end(), comp);
+  const auto dup = std::adjacent_find(data.begin(), data.end(), std::not_fn(comp));
+  if (dup != data.end()) {
+    const auto node =
+      ::ezconfig::yaml::detail::FindDuplicate(yaml, *dup, comp, [](const auto & item) -> Node { return item; });
+    throw YAML::ParserException(node.Mark(), "Double value in set");
+  }
+
+  obj = ezconfig::FlatSet<T, C>(ezconfig::sorted_unique, std::move(data), comp);
+  return true;
+}
+
+template<typename T, typename C>
+Node convert<ezconfig::FlatSet<T, C>>::encode(const ezconfig::FlatSet<T, C> & obj)
+{
+  Node node(NodeType::Sequence);
+  for (const auto & val : obj) { node.push_back(val); }
+  return node;
+}
+
+template<typename T, std::size_t N>
+bool convert<ezconfig::SmallVector<T, N>>::decode(const Node & yaml, ezconfig::SmallVector<T, N> & obj)
+{
+  if (!yaml.IsSequence()) { return false; }
+  obj.clear();
+  obj.reserve(yaml.size());
+  for (const auto & item : yaml) { obj.emplace_back(::ezconfig::yaml::As<T>(item)); }
+  return true;
+}
+
+template<typename T, std::size_t N>
+Node convert<ezconfig::SmallVector<T, N>>::encode(const ezconfig::SmallVector<T, N> & obj)
+{
+  Node node(NodeType::Sequence);
+  for (const auto & val : obj) { node.push_back(val); }
+  return node;
+}
+
+}  // namespace YAML
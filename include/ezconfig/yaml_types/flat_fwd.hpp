@@ -0,0 +1,51 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#pragma once
+
+#include <cstddef>
+
+#include "../flat.hpp"
+
+namespace YAML {
+
+// forward declarations
+template<typename T>
+struct convert;
+
+class Node;
+
+/**
+ * @brief Convert an ezconfig::FlatMap to/from yaml.
+ *
+ * The entries are decoded into a vector that is sorted once. Duplicate keys are an error.
+ */
+template<typename K, typename V, typename C>
+struct convert<ezconfig::FlatMap<K, V, C>>
+{
+  static bool decode(const Node & yaml, ezconfig::FlatMap<K, V, C> & obj);
+  static Node encode(const ezconfig::FlatMap<K, V, C> & rhs);
+};
+
+/**
+ * @brief Convert an ezconfig::FlatSet to/from a yaml list.
+ *
+ * The values are decoded into a vector that is sorted once. Duplicate values are an error.
+ */
+template<typename T, typename C>
+struct convert<ezconfig::FlatSet<T, C>>
+{
+  static bool decode(const Node & yaml, ezconfig::FlatSet<T, C> & obj);
+  static Node encode(const ezconfig::FlatSet<T, C> & rhs);
+};
+
+/**
+ * @brief Convert an ezconfig::SmallVector to/from a yaml list.
+ */
+template<typename T, std::size_t N>
+struct convert<ezconfig::SmallVector<T, N>>
+{
+  static bool decode(const Node & yaml, ezconfig::SmallVector<T, N> & obj);
+  static Node encode(const ezconfig::SmallVector<T, N> & rhs);
+};
+
+}  // namespace YAML
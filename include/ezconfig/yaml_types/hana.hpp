@@ -2,13 +2,14 @@
 
 #pragma once
 
-#include <boost/hana/at_key.hpp>
-#include <boost/hana/for_each.hpp>
-#include <boost/hana/keys.hpp>
-#include <boost/hana/map.hpp>
+#include <array>
+#include <string>
+
 #include <yaml-cpp/yaml.h>
 
+#include "decode.hpp"
 #include "hana_fwd.hpp"
+#include "hana_table.hpp"
 
 namespace YAML {
 
@@ -16,11 +17,31 @@ template<typename T>
   requires(boost::hana::Struct<T>::value)
 bool convert<T>::decode(const Node & yaml, T & t)
 {
-  boost::hana::for_each(boost::hana::keys(t), [&](auto key) {
-    using ValT                  = std::decay_t<decltype(boost::hana::at_key(t, key))>;
-    char const * key_c          = boost::hana::to<char const *>(key);
-    boost::hana::at_key(t, key) = yaml[key_c].template as<ValT>();
-  });
+  using Table = ::ezconfig::detail::HanaStructTable<T>;
+
+  if (!yaml.IsMap()) { return false; }
+
+  // single pass over the map, the first occurrence of a key is used like in Node::operator[]
+  std::array<bool, Table::kSize> found{};
+  for (const auto & kv : yaml) {
+    const auto & key = kv.first.Scalar();
+    const auto i     = Table::find(key);
+    if (i == Table::kSize) {
+      if constexpr (::ezconfig::hana_strict_keys<T>::value) {
+        throw ParserException(kv.first.Mark(), "Unknown key '" + key + "'");
+      }
+      continue;
+    }
+    if (found[i]) { continue; }
+    found[i] = true;
+    Table::visit(i, t, [&](auto & member) {
+      member = ::ezconfig::yaml::As<std::decay_t<decltype(member)>>(kv.second);
+    });
+  }
+
+  for (auto i = 0u; i < Table::kSize; ++i) {
+    if (!found[i]) { throw ParserException(yaml.Mark(), "Missing key '" + std::string(Table::kKeys[i]) + "'"); }
+  }
 
   return true;
 }
@@ -28,18 +49,12 @@ bool convert<T>::decode(const Node & yaml, T & t)
 template<typename... Ts>
 bool convert<std::variant<Ts...>>::decode(const Node & yaml, std::variant<Ts...> & obj)
 {
-  const auto & hana_map = ::ezconfig::variant_hana_maps<std::variant<Ts...>>::value;
-
-  bool ret = false;
-  boost::hana::for_each(hana_map, [&](const auto & entry) {
-    if (boost::hana::first(entry) == yaml.Tag()) {
-      using type = std::decay_t<decltype(boost::hana::second(entry))>::type;
-      obj        = yaml.template as<type>();
-      ret        = true;
-    }
-  });
+  using Table = ::ezconfig::detail::VariantTagTable<std::variant<Ts...>>;
 
-  return ret;
+  const auto i = Table::find(yaml.Tag());
+  if (i == Table::kSize) { return false; }
+  Table::visit(i, [&]<typename T, std::size_t J>() { obj.template emplace<J>(yaml.template as<T>()); });
+  return true;
 }
 
 }  // namespace YAML
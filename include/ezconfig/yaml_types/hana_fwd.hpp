@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <type_traits>
 #include <variant>
 
 #include <boost/hana/concept/struct.hpp>
@@ -35,6 +36,22 @@ template<typename T>
 struct variant_hana_maps
 {};
 
+/**
+ * @brief Type trait to reject unknown keys when decoding a boost::hana struct.
+ *
+ * By default keys that are not members of the struct are ignored.
+ *
+ * Example:
+ * @code
+ * template<>
+ * struct ezconfig::hana_strict_keys<MyStruct> : std::true_type
+ * {};
+ * @endcode
+ */
+template<typename T>
+struct hana_strict_keys : std::false_type
+{};
+
 }  // namespace ezconfig
 
 namespace YAML {
@@ -47,6 +64,9 @@ class Node;
 
 /**
  * @brief Decode a boost::hana struct from yaml.
+ *
+ * The yaml must be a map that contains all members. Unknown keys are ignored unless
+ * @ref ezconfig::hana_strict_keys is specialized for T.
  */
 template<typename T>
   requires(boost::hana::Struct<T>::value)
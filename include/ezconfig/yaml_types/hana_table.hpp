@@ -0,0 +1,116 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <boost/hana/accessors.hpp>
+#include <boost/hana/at.hpp>
+#include <boost/hana/first.hpp>
+#include <boost/hana/length.hpp>
+#include <boost/hana/pair.hpp>
+#include <boost/hana/second.hpp>
+#include <boost/hana/string.hpp>
+#include <boost/hana/tuple.hpp>
+
+#include "../meta.hpp"
+#include "hana_fwd.hpp"
+
+namespace ezconfig::detail {
+
+/**
+ * @brief Compile-time member table of a boost::hana struct.
+ *
+ * The member names are placed in a StaticStringTable, so that a key is matched to a member with one
+ * hash and (usually) one string comparison. Decoders iterate over the keys of a map once and
+ * dispatch each key to its member, instead of looking up every member in the map.
+ */
+template<typename T>
+struct HanaStructTable
+{
+  static constexpr auto kAccessors = boost::hana::accessors<T>();
+
+  /// @brief Number of members.
+  static constexpr std::size_t kSize = decltype(boost::hana::length(kAccessors))::value;
+
+  /// @brief Member names.
+  static constexpr StaticStringTable<kSize> kKeys = []<std::size_t... I>(std::index_sequence<I...>) {
+    return StaticStringTable<kSize>({
+      std::string_view(boost::hana::to<char const *>(boost::hana::first(boost::hana::at_c<I>(kAccessors))))...});
+  }(std::make_index_sequence<kSize>{});
+
+  /// @brief Index of the member with a name, or kSize if there is none.
+  static constexpr std::size_t find(std::string_view key) noexcept { return kKeys.find(key); }
+
+  /**
+   * @brief Call f(member) for the member with index i.
+   *
+   * Dispatches through a table of function pointers, one per member.
+   */
+  template<typename F>
+  static void visit(std::size_t i, T & t, F && f)
+  {
+    using VisitT = void (*)(T &, F &);
+    static constexpr auto kVisitors = []<std::size_t... I>(std::index_sequence<I...>) {
+      return std::array<VisitT, kSize>{
+        [](T & obj, F & g) { g(boost::hana::second(boost::hana::at_c<I>(kAccessors))(obj)); }...};
+    }(std::make_index_sequence<kSize>{});
+    kVisitors[i](t, f);
+  }
+};
+
+/**
+ * @brief Compile-time tag table of a variant, see ezconfig::variant_hana_maps.
+ *
+ * A tag is matched to its alternative with one hash and (usually) one string comparison.
+ */
+template<typename V>
+struct VariantTagTable
+{
+  static constexpr const auto & kMap = ::ezconfig::variant_hana_maps<V>::value;
+
+  /// @brief Number of tags.
+  static constexpr std::size_t kSize = decltype(boost::hana::length(kMap))::value;
+
+  /// @brief Tags.
+  static constexpr StaticStringTable<kSize> kTags = []<std::size_t... I>(std::index_sequence<I...>) {
+    return StaticStringTable<kSize>({std::string_view(boost::hana::first(boost::hana::at_c<I>(kMap)))...});
+  }(std::make_index_sequence<kSize>{});
+
+  /// @brief Index of a tag, or kSize if there is none.
+  static constexpr std::size_t find(std::string_view tag) noexcept { return kTags.find(tag); }
+
+  /**
+   * @brief Call f.template operator()<T, J>() for the tag with index i.
+   *
+   * T is the type of the tag, and J the index of T in the variant.
+   */
+  template<typename F>
+  static void visit(std::size_t i, F && f)
+  {
+    using VisitT = void (*)(F &);
+    static constexpr auto kVisitors = []<std::size_t... I>(std::index_sequence<I...>) {
+      return std::array<VisitT, kSize>{[](F & g) {
+        using T = typename std::decay_t<decltype(boost::hana::second(boost::hana::at_c<I>(kMap)))>::type;
+        g.template operator()<T, variant_index<T>(std::type_identity<V>{})>();
+      }...};
+    }(std::make_index_sequence<kSize>{});
+    kVisitors[i](f);
+  }
+
+private:
+  template<typename T, typename... Ts>
+  static constexpr std::size_t variant_index(std::type_identity<std::variant<Ts...>>)
+  {
+    constexpr auto ret = index_in_typepack<T, Ts...>();
+    static_assert(ret < sizeof...(Ts), "variant_hana_maps type must appear exactly once in the variant");
+    return ret;
+  }
+};
+
+}  // namespace ezconfig::detail
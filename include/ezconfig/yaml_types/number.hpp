@@ -0,0 +1,85 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+/**
+ * @file number.hpp
+ * @brief Fast decoding of numeric yaml scalars.
+ *
+ * yaml-cpp converts scalars to numbers through a std::stringstream. ParseNumber() uses
+ * std::from_chars instead, see also ezconfig::yaml::As() in decode.hpp.
+ */
+
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace ezconfig::yaml {
+
+// clang-format off
+/// @brief Types with a fast decoding path (character types are left to yaml-cpp).
+template<typename T>
+concept FastNumber = std::is_floating_point_v<T>
+                  || (std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) > 1);
+// clang-format on
+
+/**
+ * @brief Parse a number with the same rules as yaml-cpp.
+ *
+ * - Floats: decimal notation and the yaml spellings of infinity and nan (".inf", "-.inf", ".nan", ...).
+ * - Integers: decimal, hexadecimal ("0x1f"), and octal with a leading zero ("017").
+ *
+ * @return the number, or std::nullopt if the string is not handled by the fast path.
+ */
+template<FastNumber T>
+std::optional<T> ParseNumber(std::string_view s) noexcept
+{
+  const char * first = s.data();
+  const char * last  = s.data() + s.size();
+  const bool neg     = first != last && *first == '-';
+  T value{};
+
+  if constexpr (std::is_floating_point_v<T>) {
+    const std::size_t sign = neg || (first != last && *first == '+');
+    if (s.size() >= 4 && s[sign] == '.') {
+      const auto rest = s.substr(sign + 1);
+      if (rest == "inf" || rest == "Inf" || rest == "INF") {
+        return neg ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+      }
+      if (!sign && (rest == "nan" || rest == "NaN" || rest == "NAN")) { return std::numeric_limits<T>::quiet_NaN(); }
+    }
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    // from_chars also accepts "inf" and "nan", which yaml-cpp does not
+    const char * p = first + neg;
+    if (p == last || !((*p >= '0' && *p <= '9') || *p == '.')) { return std::nullopt; }
+    const auto [ptr, ec] = std::from_chars(first, last, value);
+    if (ec == std::errc{} && ptr == last) { return value; }
+#endif
+    return std::nullopt;
+  } else {
+    // yaml-cpp detects the base like strtol with base 0
+    int base       = 10;
+    const char * p = first + neg;
+    if (last - p > 1 && *p == '0') {
+      if (neg) { return std::nullopt; }
+      if (p[1] == 'x' || p[1] == 'X') {
+        base = 16;
+        p += 2;
+      } else {
+        base = 8;
+        ++p;
+      }
+    } else {
+      p = first;
+    }
+    const auto [ptr, ec] = std::from_chars(p, last, value, base);
+    if (ec == std::errc{} && ptr == last && ptr != p) { return value; }
+    return std::nullopt;
+  }
+}
+
+}  // namespace ezconfig::yaml
@@ -2,11 +2,144 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
 #include <yaml-cpp/yaml.h>
 
+#include "../meta.hpp"
 #include "eigen.hpp"
 #include "smooth_fwd.hpp"
 
+namespace ezconfig::yaml::detail {
+
+/// @brief Pose coefficients in the order x, y, z, qx, qy, qz, qw.
+template<typename T>
+using PoseCoeffs = std::array<T, 7>;
+
+/// @brief Layout of the poses in a trajectory, see YAML::convert<smooth::SE3<T>>.
+enum class PoseLayout {
+  Flat,         ///< format 2
+  Nested,       ///< format 1 with w, x, y, z orientation keys
+  NestedPrefix  ///< format 1 with qw, qx, qy, qz orientation keys
+};
+
+inline constexpr ::ezconfig::StaticStringTable<7> kFlatPoseKeys({"x", "y", "z", "qx", "qy", "qz", "qw"});
+inline constexpr ::ezconfig::StaticStringTable<4> kQuatKeys({"x", "y", "z", "w"});
+inline constexpr ::ezconfig::StaticStringTable<4> kQuatPrefixKeys({"qx", "qy", "qz", "qw"});
+inline constexpr ::ezconfig::StaticStringTable<3> kVecKeys({"x", "y", "z"});
+
+/// @brief Layout of a pose, checked in the same order as YAML::convert<smooth::SE3<T>>::decode().
+inline PoseLayout DetectPoseLayout(const YAML::Node & yaml)
+{
+  if (yaml["qw"]) { return PoseLayout::Flat; }
+  if (const auto orientation = yaml["orientation"]; orientation && !orientation["w"] && orientation["qw"]) {
+    return PoseLayout::NestedPrefix;
+  }
+  return PoseLayout::Nested;
+}
+
+/**
+ * @brief Decode the values of a map with the keys in a table, out[i] is set from the key with index i.
+ *
+ * @return true if the node is a map that contains all keys, other keys are ignored.
+ */
+template<typename T, std::size_t N>
+bool DecodeKeys(const YAML::Node & yaml, const ::ezconfig::StaticStringTable<N> & keys, T * out)
+{
+  if (!yaml.IsMap()) { return false; }
+  std::size_t found = 0;
+  for (const auto & kv : yaml) {
+    if (const auto i = keys.find(kv.first.Scalar()); i < N) {
+      out[i] = As<T>(kv.second);
+      found |= std::size_t{1} << i;
+    }
+  }
+  return found == (std::size_t{1} << N) - 1;
+}
+
+/// @brief Decode a pose with a known layout, returns false if it does not have that layout.
+template<typename T>
+bool DecodePose(const YAML::Node & yaml, PoseLayout layout, PoseCoeffs<T> & out)
+{
+  if (layout == PoseLayout::Flat) { return DecodeKeys(yaml, kFlatPoseKeys, out.data()); }
+  if (!yaml.IsMap()) { return false; }
+
+  bool translation = false, orientation = false;
+  for (const auto & kv : yaml) {
+    const std::string_view key = kv.first.Scalar();
+    if (key == "translation") {
+      if (kv.second.IsSequence() && kv.second.size() == 3) {
+        for (std::size_t i = 0; const auto & item : kv.second) { out[i++] = As<T>(item); }
+        translation = true;
+      } else {
+        translation = DecodeKeys(kv.second, kVecKeys, out.data());
+      }
+    } else if (key == "orientation") {
+      orientation =
+        DecodeKeys(kv.second, layout == PoseLayout::Nested ? kQuatKeys : kQuatPrefixKeys, out.data() + 3);
+    }
+  }
+  return translation && orientation;
+}
+
+/**
+ * @brief Decode all poses of a trajectory and call f(i, coeffs) for pose i.
+ *
+ * Poses that do not have the layout of the first pose are decoded with
+ * YAML::convert<smooth::SE3<T>>, so that they report errors as usual.
+ */
+template<typename T, typename F>
+void DecodePoses(const YAML::Node & yaml, F && f)
+{
+  if (yaml.size() == 0) { return; }
+  const auto layout = DetectPoseLayout(*yaml.begin());
+
+  PoseCoeffs<T> coeffs;
+  for (std::size_t i = 0; const auto & pose : yaml) {
+    if (!DecodePose(pose, layout, coeffs)) {
+      // so3() and r3() of smooth::SE3 return maps, copy them into values
+      const auto se3               = pose.template as<smooth::SE3<T>>();
+      const Eigen::Quaternion<T> q = se3.so3().quat();
+      const Eigen::Vector3<T> r    = se3.r3();
+      coeffs                       = {r.x(), r.y(), r.z(), q.x(), q.y(), q.z(), q.w()};
+    }
+    f(i++, coeffs);
+  }
+}
+
+/// @brief Encode a pose in format 2.
+template<typename T>
+YAML::Node EncodePose(const Eigen::Vector3<T> & translation, const Eigen::Quaternion<T> & quaternion)
+{
+  YAML::Node ret;
+  ret.force_insert("x", translation.x());
+  ret.force_insert("y", translation.y());
+  ret.force_insert("z", translation.z());
+  ret.force_insert("qw", quaternion.w());
+  ret.force_insert("qx", quaternion.x());
+  ret.force_insert("qy", quaternion.y());
+  ret.force_insert("qz", quaternion.z());
+  return ret;
+}
+
+template<typename T, typename A>
+bool VectorDecoder<std::vector<smooth::SE3<T>, A>>::decode(
+  const YAML::Node & yaml, std::vector<smooth::SE3<T>, A> & obj)
+{
+  if (!yaml.IsSequence()) { return false; }
+  obj.resize(yaml.size());
+  DecodePoses<T>(yaml, [&](std::size_t i, const auto & c) {
+    obj[i] = smooth::SE3<T>(
+      smooth::SO3<T>(Eigen::Quaternion<T>(c[6], c[3], c[4], c[5])), Eigen::Vector3<T>(c[0], c[1], c[2]));
+  });
+  return true;
+}
+
+}  // namespace ezconfig::yaml::detail
+
 namespace YAML {
 
 template<typename T>
@@ -14,13 +147,13 @@ bool convert<smooth::SO2<T>>::decode(const Node & yaml, smooth::SO2<T> & obj)
 {
   if (yaml.IsMap()) {
     if (yaml["qz"]) {
-      obj = smooth::SO2<T>(yaml["qz"].template as<T>(), yaml["qw"].template as<T>());
+      obj = smooth::SO2<T>(::ezconfig::yaml::As<T>(yaml["qz"]), ::ezconfig::yaml::As<T>(yaml["qw"]));
     } else if (yaml["z"]) {
-      obj = smooth::SO2<T>(yaml["z"].template as<T>(), yaml["w"].template as<T>());
+      obj = smooth::SO2<T>(::ezconfig::yaml::As<T>(yaml["z"]), ::ezconfig::yaml::As<T>(yaml["w"]));
     }
     return false;
   } else {
-    obj = smooth::SO2<T>(yaml.template as<T>());
+    obj = smooth::SO2<T>(::ezconfig::yaml::As<T>(yaml));
   }
   return true;
 }
@@ -48,6 +181,12 @@ bool convert<smooth::SO3<T>>::decode(const Node & yaml, smooth::SO3<T> & obj)
   return true;
 }
 
+template<typename T>
+Node convert<smooth::SE3<T>>::encode(const smooth::SE3<T> & obj)
+{
+  return ::ezconfig::yaml::detail::EncodePose<T>(Eigen::Vector3<T>(obj.r3()), Eigen::Quaternion<T>(obj.so3().quat()));
+}
+
 template<typename T>
 bool convert<smooth::SE3<T>>::decode(const Node & yaml, smooth::SE3<T> & obj)
 {
@@ -61,4 +200,29 @@ bool convert<smooth::SE3<T>>::decode(const Node & yaml, smooth::SE3<T> & obj)
   return true;
 }
 
+template<typename T>
+Node convert<ezconfig::SE3Trajectory<T>>::encode(const ezconfig::SE3Trajectory<T> & obj)
+{
+  Node ret(NodeType::Sequence);
+  for (Eigen::Index i = 0; i < obj.translation.cols(); ++i) {
+    ret.push_back(::ezconfig::yaml::detail::EncodePose<T>(
+      obj.translation.col(i), Eigen::Quaternion<T>(obj.quaternion.col(i))));
+  }
+  return ret;
+}
+
+template<typename T>
+bool convert<ezconfig::SE3Trajectory<T>>::decode(const Node & yaml, ezconfig::SE3Trajectory<T> & obj)
+{
+  if (!yaml.IsSequence()) { return false; }
+  obj.resize(yaml.size());
+  ::ezconfig::yaml::detail::DecodePoses<T>(yaml, [&](std::size_t i, const auto & c) {
+    const auto col = static_cast<Eigen::Index>(i);
+    const smooth::SO3<T> so3(Eigen::Quaternion<T>(c[6], c[3], c[4], c[5]));
+    obj.translation.col(col) = Eigen::Vector3<T>(c[0], c[1], c[2]);
+    obj.quaternion.col(col)  = so3.quat().coeffs();
+  });
+  return true;
+}
+
 }  // namespace YAML
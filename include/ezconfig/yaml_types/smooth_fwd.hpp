@@ -2,11 +2,50 @@
 
 #pragma once
 
+#include <cstddef>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
 #include <smooth/se2.hpp>
 #include <smooth/se3.hpp>
 #include <smooth/so2.hpp>
 #include <smooth/so3.hpp>
 
+namespace ezconfig {
+
+/**
+ * @brief Trajectory of se3 poses stored as arrays of translations and quaternions.
+ *
+ * Column i holds pose i, with the quaternion coefficients in Eigen order (x, y, z, w).
+ */
+template<typename T>
+struct SE3Trajectory
+{
+  Eigen::Matrix<T, 3, Eigen::Dynamic> translation;
+  Eigen::Matrix<T, 4, Eigen::Dynamic> quaternion;
+
+  /// @brief Number of poses.
+  std::size_t size() const noexcept { return static_cast<std::size_t>(translation.cols()); }
+
+  /// @brief Resize to n poses, the contents are left uninitialized.
+  void resize(std::size_t n)
+  {
+    translation.resize(3, static_cast<Eigen::Index>(n));
+    quaternion.resize(4, static_cast<Eigen::Index>(n));
+  }
+
+  /// @brief Pose with index i.
+  smooth::SE3<T> operator[](std::size_t i) const
+  {
+    const auto col = static_cast<Eigen::Index>(i);
+    return smooth::SE3<T>(
+      smooth::SO3<T>(Eigen::Quaternion<T>(quaternion.col(col))), Eigen::Vector3<T>(translation.col(col)));
+  }
+};
+
+}  // namespace ezconfig
+
 namespace YAML {
 
 // forward declarations
@@ -63,7 +102,7 @@ struct convert<smooth::SE2<T>>
 };
 
 /**
- * @brief Decode an enum from yaml.
+ * @brief Decode so3 from yaml.
  *
  * Supported formats: same as Eigen quaternion.
  */
@@ -74,7 +113,7 @@ struct convert<smooth::SO3<T>>
 };
 
 /**
- * @brief Decode se3 object from yaml.
+ * @brief Decode and encode se3 object from yaml.
  *
  * Supported formats:
  *
@@ -88,14 +127,51 @@ struct convert<smooth::SO3<T>>
  *   y: <floating>
  *   z: <floating>
  *   qw: <floating>
- *   qz: <floating>
+ *   qx: <floating>
  *   qy: <floating>
  *   qz: <floating>
+ *
+ * Poses are encoded in format 2.
  */
 template<typename T>
 struct convert<smooth::SE3<T>>
 {
+  static Node encode(const smooth::SE3<T> & obj);
   static bool decode(const Node & yaml, smooth::SE3<T> & obj);
 };
 
+/**
+ * @brief Decode and encode a trajectory of se3 poses into arrays.
+ *
+ * Same format as std::vector<smooth::SE3<T>>.
+ */
+template<typename T>
+struct convert<ezconfig::SE3Trajectory<T>>
+{
+  static Node encode(const ezconfig::SE3Trajectory<T> & obj);
+  static bool decode(const Node & yaml, ezconfig::SE3Trajectory<T> & obj);
+};
+
 }  // namespace YAML
+
+namespace ezconfig::yaml::detail {
+
+template<typename Vector>
+struct VectorDecoder;
+
+/**
+ * @brief Decode a trajectory of se3 poses with ezconfig::yaml::As().
+ *
+ * Every pose has one of the se3 formats. The format of the first pose is detected once, and all
+ * poses are decoded into a vector sized up front with a single pass over the keys of each pose.
+ *
+ * @note Declared here rather than as a YAML::convert specialization since yaml-cpp already converts
+ * std::vector, yaml.as<std::vector<smooth::SE3<T>>>() decodes pose by pose.
+ */
+template<typename T, typename A>
+struct VectorDecoder<std::vector<smooth::SE3<T>, A>>
+{
+  static bool decode(const YAML::Node & yaml, std::vector<smooth::SE3<T>, A> & obj);
+};
+
+}  // namespace ezconfig::yaml::detail
@@ -2,8 +2,14 @@
 
 #pragma once
 
+#include <cstddef>
+#include <system_error>
+#include <utility>
+
 #include <yaml-cpp/yaml.h>
 
+#include "../duration.hpp"
+#include "decode.hpp"
 #include "stl_fwd.hpp"
 
 namespace YAML {
@@ -14,7 +20,7 @@ bool convert<std::optional<T>>::decode(const Node & yaml, std::optional<T> & obj
   if (yaml.IsNull()) {
     obj = std::nullopt;
   } else {
-    obj = yaml.as<T>();
+    obj = ::ezconfig::yaml::As<T>(yaml);
   }
   return true;
 }
@@ -29,14 +35,34 @@ Node convert<std::optional<T>>::encode(const std::optional<T> & obj)
   }
 }
 
+template<typename A>
+bool convert<std::basic_string<char, std::char_traits<char>, A>>::decode(
+  const Node & yaml, std::basic_string<char, std::char_traits<char>, A> & obj)
+{
+  if (!yaml.IsScalar()) { return false; }
+  obj.assign(yaml.Scalar());
+  return true;
+}
+
+template<typename A>
+Node convert<std::basic_string<char, std::char_traits<char>, A>>::encode(
+  const std::basic_string<char, std::char_traits<char>, A> & obj)
+{
+  return Node(std::string(obj));
+}
+
 template<typename K, typename V, typename C, typename A>
 bool convert<std::unordered_map<K, V, C, A>>::decode(const Node & yaml, std::unordered_map<K, V, C, A> & obj)
 {
+  if (!yaml.IsMap()) { return false; }
   obj.clear();
+  obj.reserve(yaml.size());
   for (const auto & node : yaml) {
-    const auto key = node.first.as<std::string>();
-    if (obj.contains(key)) { throw YAML::ParserException(yaml.Mark(), "Double key '" + key + "' in map"); }
-    obj[node.first.as<K>()] = node.second.as<V>();
+    const auto inserted =
+      obj.try_emplace(::ezconfig::yaml::As<K>(node.first), ::ezconfig::yaml::As<V>(node.second)).second;
+    if (!inserted) {
+      throw YAML::ParserException(node.first.Mark(), "Double key '" + node.first.Scalar() + "' in map");
+    }
   }
   return true;
 }
@@ -49,6 +75,67 @@ Node convert<std::unordered_map<K, V, C, A>>::encode(const std::unordered_map<K,
   return node;
 }
 
+template<typename T, typename C, typename A>
+bool convert<std::set<T, C, A>>::decode(const Node & yaml, std::set<T, C, A> & obj)
+{
+  if (!yaml.IsSequence()) { return false; }
+  obj.clear();
+  for (const auto & node : yaml) {
+    const auto size = obj.size();
+    obj.emplace_hint(obj.end(), ::ezconfig::yaml::As<T>(node));
+    if (obj.size() == size) { throw YAML::ParserException(node.Mark(), "Double value in set"); }
+  }
+  return true;
+}
+
+template<typename T, typename C, typename A>
+Node convert<std::set<T, C, A>>::encode(const std::set<T, C, A> & obj)
+{
+  YAML::Node node(NodeType::Sequence);
+  for (const auto & val : obj) { node.push_back(val); }
+  return node;
+}
+
+template<typename T, typename H, typename P, typename A>
+bool convert<std::unordered_set<T, H, P, A>>::decode(const Node & yaml, std::unordered_set<T, H, P, A> & obj)
+{
+  if (!yaml.IsSequence()) { return false; }
+  obj.clear();
+  obj.reserve(yaml.size());
+  for (const auto & node : yaml) {
+    if (!obj.insert(::ezconfig::yaml::As<T>(node)).second) {
+      throw YAML::ParserException(node.Mark(), "Double value in set");
+    }
+  }
+  return true;
+}
+
+template<typename T, typename H, typename P, typename A>
+Node convert<std::unordered_set<T, H, P, A>>::encode(const std::unordered_set<T, H, P, A> & obj)
+{
+  YAML::Node node(NodeType::Sequence);
+  for (const auto & val : obj) { node.push_back(val); }
+  return node;
+}
+
+template<typename... Ts>
+bool convert<std::tuple<Ts...>>::decode(const Node & yaml, std::tuple<Ts...> & obj)
+{
+  if (!yaml.IsSequence() || yaml.size() != sizeof...(Ts)) { return false; }
+  [&]<std::size_t... I>(std::index_sequence<I...>) {
+    ((std::get<I>(obj) = ::ezconfig::yaml::As<Ts>(yaml[I])), ...);
+  }(std::index_sequence_for<Ts...>{});
+  return true;
+}
+
+template<typename... Ts>
+Node convert<std::tuple<Ts...>>::encode(const std::tuple<Ts...> & obj)
+{
+  YAML::Node node(NodeType::Sequence);
+  std::apply([&](const auto &... vals) { (node.push_back(vals), ...); }, obj);
+  return node;
+}
+
 inline bool convert<std::filesystem::path>::decode(const Node & yaml, std::filesystem::path & obj)
 {
   obj = yaml.as<std::string>();
@@ -57,54 +144,28 @@ inline bool convert<std::filesystem::path>::decode(const Node & yaml, std::files
 
 inline Node convert<std::filesystem::path>::encode(const std::filesystem::path & obj) { return Node(obj.string()); }
 
-template<intmax_t Num, intmax_t Den>
-bool convert<std::chrono::duration<int64_t, std::ratio<Num, Den>>>::decode(
-  const Node & yaml, std::chrono::duration<int64_t, std::ratio<Num, Den>> & obj)
+template<typename Rep, typename Period>
+bool convert<std::chrono::duration<Rep, Period>>::decode(const Node & yaml, std::chrono::duration<Rep, Period> & obj)
 {
-  using RetType  = std::chrono::duration<int64_t, std::ratio<Num, Den>>;
-  const auto str = yaml.as<std::string>();
-  if (str.ends_with("ms")) {
-    obj = std::chrono::duration_cast<RetType>(std::chrono::milliseconds(std::stoi(str.substr(0, str.size() - 2))));
-  } else if (str.ends_with("us")) {
-    obj = std::chrono::duration_cast<RetType>(std::chrono::microseconds(std::stoi(str.substr(0, str.size() - 2))));
-  } else if (str.ends_with("ns")) {
-    obj = std::chrono::duration_cast<RetType>(std::chrono::nanoseconds(std::stoi(str.substr(0, str.size() - 2))));
-  } else if (str.ends_with("s")) {
-    obj = std::chrono::duration_cast<RetType>(std::chrono::seconds(std::stoi(str.substr(0, str.size() - 1))));
-  } else if (str.ends_with("m")) {
-    obj = std::chrono::duration_cast<RetType>(std::chrono::minutes(std::stoi(str.substr(0, str.size() - 1))));
-  } else if (str.ends_with("h")) {
-    obj = std::chrono::duration_cast<RetType>(std::chrono::hours(std::stoi(str.substr(0, str.size() - 1))));
-  } else {
+  if (!yaml.IsScalar()) { return false; }
+  const auto & str = yaml.Scalar();
+  const auto ec = ::ezconfig::ParseDuration(str, obj);
+  if (ec == std::errc::result_out_of_range) {
+    throw YAML::ParserException{yaml.Mark(), "Duration '" + str + "' is out of range"};
+  }
+  if (ec != std::errc{}) {
     throw YAML::ParserException{
       yaml.Mark(),
-      "Could not detect suffix in '" + str + "', expected s, ms, us, or ns",
+      "Could not parse duration '" + str + "', expected e.g. 40ms, 1.5s, or 1h30m",
     };
   }
-
   return true;
 }
 
-template<intmax_t Num, intmax_t Den>
-Node convert<std::chrono::duration<int64_t, std::ratio<Num, Den>>>::encode(
-  const std::chrono::duration<int64_t, std::ratio<Num, Den>> & obj)
+template<typename Rep, typename Period>
+Node convert<std::chrono::duration<Rep, Period>>::encode(const std::chrono::duration<Rep, Period> & obj)
 {
-  using R = std::ratio<Num, Den>;
-  if constexpr (std::is_same_v<R, std::milli>) {
-    return std::to_string(obj.count()) + "ms";
-  } else if constexpr (std::is_same_v<R, std::micro>) {
-    return std::to_string(obj.count()) + "us";
-  } else if constexpr (std::is_same_v<R, std::nano>) {
-    return std::to_string(obj.count()) + "ns";
-  } else if constexpr (std::is_same_v<R, std::ratio<1>>) {
-    return std::to_string(obj.count()) + "s";
-  } else if constexpr (std::is_same_v<R, std::ratio<60>>) {
-    return std::to_string(obj.count()) + "m";
-  } else if constexpr (std::is_same_v<R, std::ratio<3600>>) {
-    return std::to_string(obj.count()) + "h";
-  } else {
-    return std::to_string(std::chrono::duration_cast<std::chrono::nanoseconds>(obj).count()) + "ns";
-  }
+  return Node(::ezconfig::FormatDuration(obj));
 }
 
 }  // namespace YAML
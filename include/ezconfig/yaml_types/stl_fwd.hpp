@@ -2,10 +2,15 @@
 
 #pragma once
 
+#include <chrono>
 #include <filesystem>
 #include <map>
 #include <optional>
+#include <set>
+#include <string>
+#include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <variant>
 #include <vector>
 
@@ -31,8 +36,22 @@ struct convert<std::optional<T>>
   static Node encode(const std::optional<T> & rhs);
 };
 
+/**
+ * @brief Convert strings with non-default allocators (e.g. std::pmr::string) to/from yaml.
+ *
+ * The string keeps its allocator.
+ */
+template<typename A>
+struct convert<std::basic_string<char, std::char_traits<char>, A>>
+{
+  static bool decode(const Node & yaml, std::basic_string<char, std::char_traits<char>, A> & obj);
+  static Node encode(const std::basic_string<char, std::char_traits<char>, A> & rhs);
+};
+
 /**
  * @brief Convert a std::unordered_map to/from yaml.
+ *
+ * Duplicate keys are an error.
  */
 template<typename K, typename V, typename C, typename A>
 struct convert<std::unordered_map<K, V, C, A>>
@@ -41,6 +60,40 @@ struct convert<std::unordered_map<K, V, C, A>>
   static Node encode(const std::unordered_map<K, V, C, A> & rhs);
 };
 
+/**
+ * @brief Convert a std::set to/from a yaml list.
+ *
+ * Duplicate values are an error.
+ */
+template<typename T, typename C, typename A>
+struct convert<std::set<T, C, A>>
+{
+  static bool decode(const Node & yaml, std::set<T, C, A> & obj);
+  static Node encode(const std::set<T, C, A> & rhs);
+};
+
+/**
+ * @brief Convert a std::unordered_set to/from a yaml list.
+ *
+ * Duplicate values are an error.
+ */
+template<typename T, typename H, typename P, typename A>
+struct convert<std::unordered_set<T, H, P, A>>
+{
+  static bool decode(const Node & yaml, std::unordered_set<T, H, P, A> & obj);
+  static Node encode(const std::unordered_set<T, H, P, A> & rhs);
+};
+
+/**
+ * @brief Convert a std::tuple to/from a yaml list of the same length.
+ */
+template<typename... Ts>
+struct convert<std::tuple<Ts...>>
+{
+  static bool decode(const Node & yaml, std::tuple<Ts...> & obj);
+  static Node encode(const std::tuple<Ts...> & rhs);
+};
+
 /**
  * @brief Convert a path to/from yaml.
  */
@@ -54,19 +107,14 @@ struct convert<std::filesystem::path>
 /**
  * @brief Convert a chrono type to/from yaml.
  *
- * The yaml representation is e.g. "40ms" or "100us". The supported suffixes are
- * - h: hours
- * - m: minutes
- * - s: seconds
- * - ms: milliseconds
- * - us: microseconds
- * - ns: nanoseconds
+ * The yaml representation is e.g. "40ms", "1.5s" or "1h30m", see ezconfig::ParseDuration() for the
+ * supported formats. Both integer and floating point Rep are supported.
  */
-template<intmax_t Num, intmax_t Den>
-struct convert<std::chrono::duration<int64_t, std::ratio<Num, Den>>>
+template<typename Rep, typename Period>
+struct convert<std::chrono::duration<Rep, Period>>
 {
-  static bool decode(const Node & yaml, std::chrono::duration<int64_t, std::ratio<Num, Den>> & obj);
-  static Node encode(const std::chrono::duration<int64_t, std::ratio<Num, Den>> & rhs);
+  static bool decode(const Node & yaml, std::chrono::duration<Rep, Period> & obj);
+  static Node encode(const std::chrono::duration<Rep, Period> & rhs);
 };
 
 }  // namespace YAML
@@ -10,6 +10,16 @@ cpmaddpackage("gh:catchorg/Catch2@3.4.0")
 include(${Catch2_SOURCE_DIR}/extras/Catch.cmake)
 cpmaddpackage("gh:jbeder/yaml-cpp#master@0.8.0")
 cpmaddpackage("gh:nlohmann/json@3.12.0")
+cpmaddpackage("gh:simdjson/simdjson@3.10.1")
+if(BUILD_RYML)
+  cpmaddpackage(
+    NAME ryml
+    VERSION 0.7.2
+    GIT_REPOSITORY https://github.com/biojppm/rapidyaml.git
+    GIT_TAG v0.7.2
+    OPTIONS "RYML_DEFAULT_CALLBACK_USES_EXCEPTIONS ON"
+  )
+endif()
 
 cpmaddpackage(
   NAME Eigen
@@ -18,7 +28,7 @@ cpmaddpackage(
   DOWNLOAD_ONLY YES
 )
 if(Eigen_ADDED)
-  add_library(Eigen INTERFACE IMPORTED)
+  add_library(Eigen INTERFACE IMPORTED GLOBAL)
   target_include_directories(Eigen INTERFACE ${Eigen_SOURCE_DIR})
 endif()
 
@@ -30,7 +40,7 @@ cpmaddpackage(
   DOWNLOAD_ONLY YES
 )
 if(Hana_ADDED)
-  add_library(Hana INTERFACE IMPORTED)
+  add_library(Hana INTERFACE IMPORTED GLOBAL)
   target_include_directories(Hana INTERFACE ${Hana_SOURCE_DIR}/include)
 endif()
 
@@ -42,7 +52,7 @@ cpmaddpackage(
   DOWNLOAD_ONLY YES
 )
 if(smooth_ADDED)
-  add_library(smooth INTERFACE IMPORTED)
+  add_library(smooth INTERFACE IMPORTED GLOBAL)
   target_include_directories(smooth INTERFACE ${smooth_SOURCE_DIR}/include)
   # hack to create version file
   configure_file(
@@ -59,6 +69,6 @@ cpmaddpackage(
   DOWNLOAD_ONLY YES
 )
 if(magic_enum_ADDED)
-  add_library(magic_enum INTERFACE IMPORTED)
+  add_library(magic_enum INTERFACE IMPORTED GLOBAL)
   target_include_directories(magic_enum INTERFACE ${magic_enum_SOURCE_DIR}/include)
 endif()
@@ -0,0 +1,214 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/json.hpp"
+#include "ezconfig/yaml.hpp"
+#include "ezconfig/yaml_json.hpp"
+
+using namespace ezconfig;
+
+class TBase
+{
+public:
+  virtual ~TBase()         = default;
+  virtual std::string id() = 0;
+};
+
+EZ_JSON_DECLARE(TBase);
+EZ_JSON_DEFINE(TBase);
+EZ_YAML_DECLARE(TBase);
+EZ_YAML_DEFINE(TBase);
+
+class TDerived1 : public TBase
+{
+public:
+  TDerived1(std::string x) : m_x(x) {}
+
+  virtual std::string id() { return m_x; }
+
+private:
+  std::string m_x;
+};
+
+struct TDerived2 : public TBase
+{
+  TDerived2(std::vector<std::unique_ptr<TBase>> && v) : x(std::move(v)) {}
+
+  std::vector<std::unique_ptr<TBase>> x;
+  virtual std::string id()
+  {
+    std::string ret;
+    for (const auto & c : x) { ret += c->id() + ","; }
+    return ret;
+  }
+};
+
+struct TDerived3 : public TBase
+{
+  int x{};
+  double y{};
+  bool z{};
+  virtual std::string id() { return std::to_string(x) + " " + std::to_string(y) + " " + std::to_string(z); }
+};
+
+void from_json(const nlohmann::json & j, TDerived3 & p)
+{
+  j.at("x").get_to(p.x);
+  j.at("y").get_to(p.y);
+  j.at("z").get_to(p.z);
+}
+
+template<>
+struct YAML::convert<TDerived3>
+{
+  static bool decode(const YAML::Node & node, TDerived3 & p)
+  {
+    p.x = node["x"].as<int>();
+    p.y = node["y"].as<double>();
+    p.z = node["z"].as<bool>();
+    return true;
+  }
+};
+
+struct TNamed : public TBase
+{
+  std::string name;
+  virtual std::string id() { return name; }
+};
+
+void from_json(const nlohmann::json & j, TNamed & p) { j.at("name").get_to(p.name); }
+
+template<>
+struct YAML::convert<TNamed>
+{
+  static bool decode(const YAML::Node & node, TNamed & p)
+  {
+    p.name = node["name"].as<std::string>();
+    return true;
+  }
+};
+
+EZ_JSON_REGISTER(TBase, "d1", TDerived1, std::string);
+EZ_JSON_REGISTER(TBase, "d2", TDerived2, std::vector<std::unique_ptr<TBase>>);
+EZ_JSON_REGISTER(TBase, "d3", TDerived3);
+EZ_JSON_REGISTER(TBase, "named", TNamed);
+
+EZ_YAML_REGISTER(TBase, "!d1", TDerived1, std::string);
+EZ_YAML_REGISTER(TBase, "!d2", TDerived2, std::vector<std::unique_ptr<TBase>>);
+EZ_YAML_REGISTER(TBase, "!d3", TDerived3);
+EZ_YAML_REGISTER(TBase, "!named", TNamed);
+
+static constexpr std::array kFormats{
+  json::BinaryFormat::Cbor, json::BinaryFormat::MsgPack, json::BinaryFormat::Bson, json::BinaryFormat::UbJson};
+
+TEST_CASE("BinaryRoundTrip")
+{
+  const auto j = nlohmann::json::parse(R"(
+  {
+    "d2": [
+      {"d1": "hello"},
+      {"d3": {"x": -3, "y": 1.5, "z": true}}
+    ]
+  }
+)");
+
+  for (const auto format : kFormats) {
+    const auto data = json::ToBinary(j, format);
+    REQUIRE(json::ParseBinary(data, format) == j);
+    REQUIRE(json::CreateFromBinary<TBase>(data, format)->id() == json::Create<TBase>(j)->id());
+  }
+
+  REQUIRE(json::CreateFromBinary<TBase>(json::ToBinary(j, json::BinaryFormat::Cbor), json::BinaryFormat::Cbor)->id()
+          == "hello,-3 1.500000 1,");
+}
+
+TEST_CASE("BinaryInvalid")
+{
+  const auto data = json::ToBinary(nlohmann::json::parse(R"({"d1": "hello"})"), json::BinaryFormat::Cbor);
+  REQUIRE_THROWS(json::ParseBinary(std::span(data).first(data.size() - 1), json::BinaryFormat::Cbor));
+  REQUIRE_THROWS(json::CreateFromBinary<TBase>(
+    json::ToBinary(nlohmann::json::parse(R"({"d4": "hello"})"), json::BinaryFormat::MsgPack),
+    json::BinaryFormat::MsgPack));
+
+  // bson requires an object at the root
+  REQUIRE_THROWS(json::ToBinary(nlohmann::json::parse(R"([1, 2])"), json::BinaryFormat::Bson));
+}
+
+TEST_CASE("YamlToJson")
+{
+  const auto y = YAML::Load(R"(
+a: ~
+b: true
+c: False
+d: -12
+e: 18446744073709551615
+f: 1.5e3
+g: .inf
+h: hello
+i: "123"
+j: 'true'
+k: [1, yes, on, Off, n]
+l: !d1 hello
+m: !d3
+  x: 1
+)");
+
+  const auto j = yaml::ToJson(y);
+  REQUIRE(j["a"].is_null());
+  REQUIRE(j["b"] == true);
+  REQUIRE(j["c"] == false);
+  REQUIRE(j["d"] == -12);
+  REQUIRE(j["e"].is_number_unsigned());
+  REQUIRE(j["e"] == 18446744073709551615u);
+  REQUIRE(j["f"] == 1500.);
+  REQUIRE(std::isinf(j["g"].get<double>()));
+  REQUIRE(j["h"] == "hello");
+  REQUIRE(j["i"] == "123");
+  REQUIRE(j["j"] == "true");
+  REQUIRE(j["k"] == nlohmann::json::parse(R"([1, true, true, false, false])"));
+  REQUIRE(j["l"] == nlohmann::json::parse(R"({"d1": "hello"})"));
+  REQUIRE(j["m"] == nlohmann::json::parse(R"({"d3": {"x": 1}})"));
+
+  REQUIRE_THROWS(yaml::ToJson(y["missing"]));
+}
+
+TEST_CASE("YamlToBinary")
+{
+  const auto y = YAML::Load(R"(
+!d2
+- !d1 hello
+- !d3
+  x: 2
+  y: 0.25
+  z: off
+- !d2
+  - !d1 abc
+)");
+
+  const auto expected = yaml::Create<TBase>(y)->id();
+  REQUIRE(expected == "hello,2 0.250000 0,abc,,");
+
+  for (const auto format : kFormats) {
+    const auto data = json::ToBinary(yaml::ToJson(y), format);
+    REQUIRE(json::CreateFromBinary<TBase>(data, format)->id() == expected);
+  }
+}
+
+TEST_CASE("YamlToJsonStringField")
+{
+  // without a schema, plain scalars that look like booleans or numbers are not converted to strings
+  for (const std::string str : {"no", "on", "y", "1.10", "007"}) {
+    const auto plain = YAML::Load("!named {name: " + str + "}");
+    REQUIRE(yaml::Create<TBase>(plain)->id() == str);
+    REQUIRE_THROWS_AS(json::Create<TBase>(yaml::ToJson(plain)), nlohmann::json::type_error);
+    const auto data = json::ToBinary(yaml::ToJson(plain), json::BinaryFormat::Cbor);
+    REQUIRE_THROWS_AS(json::CreateFromBinary<TBase>(data, json::BinaryFormat::Cbor), nlohmann::json::type_error);
+
+    // quoted scalars stay strings
+    const auto quoted = YAML::Load("!named {name: '" + str + "'}");
+    REQUIRE(json::Create<TBase>(yaml::ToJson(quoted))->id() == str);
+  }
+}
@@ -0,0 +1,115 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/factory.hpp"
+
+using namespace ezconfig;
+
+class CBase
+{
+public:
+  explicit CBase(int id) : m_id(id) {}
+  virtual ~CBase() = default;
+  int id() const { return m_id; }
+
+private:
+  int m_id;
+};
+
+TEST_CASE("ConcurrentAddCreate")
+{
+  static constexpr int kInitial = 10;
+  static constexpr int kAdded   = 2000;
+  static constexpr int kReaders = 8;
+
+  Factory<CBase, int> factory;
+  for (auto i = 0; i < kInitial; ++i) {
+    factory.add("tag" + std::to_string(i), [](int x) { return std::make_unique<CBase>(x); });
+  }
+
+  std::atomic<bool> done{false};
+  std::atomic<int> failures{0};
+  std::atomic<int> created_late{0};
+
+  {
+    // readers are stopped and joined also if an assertion below fails
+    std::vector<std::jthread> readers;
+    struct StopGuard
+    {
+      std::atomic<bool> & done;
+      ~StopGuard() { done = true; }
+    } stop_guard{done};
+
+    for (auto r = 0; r < kReaders; ++r) {
+      readers.emplace_back([&, r] {
+        std::vector<std::string> tags;
+        for (auto i = 0; i < kInitial + kAdded; ++i) { tags.push_back("tag" + std::to_string(i)); }
+
+        for (std::size_t k = static_cast<std::size_t>(r); !done.load(); k += 7) {
+          // initial tags must always be found
+          const auto i = k % kInitial;
+          if (factory.create(tags[i], static_cast<int>(i))->id() != static_cast<int>(i)) { ++failures; }
+
+          // added tags are either not yet visible, or fully visible
+          const auto j = kInitial + k % kAdded;
+          try {
+            if (factory.create(tags[j], static_cast<int>(j))->id() != static_cast<int>(j)) { ++failures; }
+            ++created_late;
+          } catch (const std::logic_error &) {
+          }
+        }
+      });
+    }
+
+    for (auto i = kInitial; i < kInitial + kAdded; ++i) {
+      factory.add("tag" + std::to_string(i), [](int x) { return std::make_unique<CBase>(x); });
+    }
+    factory.freeze();
+    for (auto i = 0; i < kInitial + kAdded; ++i) {
+      REQUIRE(factory.create("tag" + std::to_string(i), i)->id() == i);
+    }
+  }
+
+  REQUIRE(failures == 0);
+  REQUIRE(created_late > 0);
+}
+
+class LazyCBase
+{
+public:
+  virtual ~LazyCBase() = default;
+};
+
+EZ_FACTORY_DECLARE(LazyCBase);
+EZ_FACTORY_DEFINE(LazyCBase);
+
+EZ_FACTORY_REGISTER(
+  "a", [] { return std::make_unique<LazyCBase>(); }, LazyCBase);
+EZ_FACTORY_REGISTER(
+  "b", [] { return std::make_unique<LazyCBase>(); }, LazyCBase);
+
+TEST_CASE("ConcurrentFirstUse")
+{
+  // all threads see all registrations, regardless of which thread runs them
+  std::atomic<int> failures{0};
+  {
+    std::vector<std::jthread> threads;
+    for (auto t = 0; t < 8; ++t) {
+      threads.emplace_back([&] {
+        try {
+          EZ_FACTORY_INSTANCE(LazyCBase).create("a");
+          EZ_FACTORY_INSTANCE(LazyCBase).create("b");
+        } catch (const std::logic_error &) {
+          ++failures;
+        }
+      });
+    }
+  }
+  REQUIRE(failures == 0);
+}
@@ -0,0 +1,137 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/flat.hpp"
+#include "ezconfig/yaml_types/flat.hpp"
+#include "ezconfig/yaml_types/stl.hpp"
+
+using namespace std::literals;
+
+TEST_CASE("FlatMap")
+{
+  ezconfig::FlatMap<std::string, int, std::less<>> map({{"b", 2}, {"a", 1}, {"c", 3}, {"a", 4}});
+
+  REQUIRE(map.size() == 3);
+  REQUIRE(map.begin()->first == "a");
+  REQUIRE(map.at("a"sv) == 1);
+  REQUIRE(map.contains("c"sv));
+  REQUIRE(!map.contains("d"sv));
+  REQUIRE_THROWS_AS(map.at("d"sv), std::out_of_range);
+
+  map["d"] = 5;
+  REQUIRE(map.insert({"0", 0}).second);
+  REQUIRE(!map.insert({"0", 1}).second);
+  REQUIRE(map.try_emplace("e", 6).second);
+  REQUIRE(map.erase("b") == 1);
+  REQUIRE(map.erase("b") == 0);
+
+  std::string keys;
+  for (const auto & [key, val] : map) { keys += key; }
+  REQUIRE(keys == "0acde");
+  REQUIRE(map.find("d"sv)->second == 5);
+
+  map.find("d")->second = 7;
+  REQUIRE(map.at("d") == 7);
+  REQUIRE(map.find("d") != map.cend());
+
+  static_assert(std::is_const_v<std::remove_reference_t<decltype((*map.begin()).first)>>);
+  static_assert(std::is_same_v<decltype((*map.begin()).second), int &>);
+}
+
+TEST_CASE("FlatMapNonTransparent")
+{
+  ezconfig::FlatMap<std::string, int> map({{"b", 2}, {"a", 1}});
+
+  REQUIRE(map.find("a")->second == 1);
+  REQUIRE(map.find("c") == map.end());
+  REQUIRE(map.contains("b"));
+  REQUIRE(map.count("c") == 0);
+  REQUIRE(std::as_const(map).at("b") == 2);
+  map.at("a") = 3;
+  REQUIRE(map.at("a") == 3);
+  REQUIRE_THROWS_AS(map.at("c"), std::out_of_range);
+
+  int sum = 0;
+  for (auto [key, val] : map) {
+    val *= 2;
+    sum += val;
+  }
+  REQUIRE(sum == 10);
+  REQUIRE(map.begin()[1].second == 4);
+  REQUIRE(map.end() - map.begin() == 2);
+}
+
+TEST_CASE("FlatSet")
+{
+  ezconfig::FlatSet<int> set{3, 1, 2, 3};
+  REQUIRE(set.size() == 3);
+  REQUIRE(*set.begin() == 1);
+  REQUIRE(set.count(2) == 1);
+  REQUIRE(set.insert(0).second);
+  REQUIRE(!set.insert(0).second);
+  REQUIRE(std::move(set).extract() == std::vector<int>{0, 1, 2, 3});
+
+  for (int n = 0; n < 20; ++n) {
+    std::vector<int> data;
+    for (int i = 0; i < n; ++i) { data.push_back(2 * i); }
+    const ezconfig::FlatSet<int> s(ezconfig::sorted_unique, data);
+    for (int k = -1; k < 2 * n + 1; ++k) {
+      REQUIRE(s.lower_bound(k) - s.begin() == std::lower_bound(data.begin(), data.end(), k) - data.begin());
+      REQUIRE(s.contains(k) == (k >= 0 && k < 2 * n && k % 2 == 0));
+    }
+  }
+}
+
+TEST_CASE("SmallVector")
+{
+  ezconfig::SmallVector<std::string, 2> vec{"a", "b"};
+  REQUIRE(vec.is_inline());
+
+  vec.push_back(vec[0]);
+  REQUIRE(!vec.is_inline());
+  REQUIRE(vec.size() == 3);
+  REQUIRE(vec.back() == "a");
+
+  const auto copy = vec;
+  REQUIRE(copy == vec);
+
+  auto moved = std::move(vec);
+  REQUIRE(moved == copy);
+  REQUIRE(vec.empty());
+  REQUIRE(vec.is_inline());
+
+  ezconfig::SmallVector<std::string, 2> small{"x"};
+  moved = std::move(small);
+  REQUIRE(moved.is_inline());
+  REQUIRE(moved == ezconfig::SmallVector<std::string, 2>{"x"});
+
+  moved.pop_back();
+  REQUIRE(moved.empty());
+}
+
+TEST_CASE("yaml_flat")
+{
+  const auto map = YAML::Load("{b: [1, 2], a: [3]}").as<ezconfig::FlatMap<std::string, std::vector<int>>>();
+  REQUIRE(map.container() == std::vector<std::pair<std::string, std::vector<int>>>{{"a", {3}}, {"b", {1, 2}}});
+  REQUIRE_THROWS_AS(
+    (YAML::Load("{b: 1, a: 2, b: 3}").as<ezconfig::FlatMap<std::string, int>>()), YAML::ParserException);
+
+  const auto set = YAML::Load("[3, 1, 2]").as<ezconfig::FlatSet<int>>();
+  REQUIRE(set == ezconfig::FlatSet<int>{1, 2, 3});
+  REQUIRE_THROWS_AS(YAML::Load("[3, 1, 3]").as<ezconfig::FlatSet<int>>(), YAML::ParserException);
+
+  const auto vec = YAML::Load("[1, 2, 3]").as<ezconfig::SmallVector<double, 2>>();
+  REQUIRE(vec == ezconfig::SmallVector<double, 2>{1, 2, 3});
+
+  YAML::Emitter em;
+  em << YAML::Node(map) << YAML::Node(set) << YAML::Node(vec);
+  REQUIRE(std::string(em.c_str()) == "a:\n  - 3\nb:\n  - 1\n  - 2\n---\n- 1\n- 2\n- 3\n---\n- 1\n- 2\n- 3");
+}
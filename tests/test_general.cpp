@@ -1,10 +1,14 @@
 // Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
 
+#include <array>
 #include <iostream>
+#include <string>
+#include <string_view>
 
 #include <catch2/catch_test_macros.hpp>
 
 #include "declaration.hpp"
+#include "ezconfig/meta.hpp"
 
 using namespace ezconfig;
 
@@ -41,3 +45,278 @@ TEST_CASE("AddExisting")
 }
 
 TEST_CASE("CreateDoesNotExist") { REQUIRE_THROWS_AS(gInstance<Factory<TestBase>>().create("d5"), std::logic_error); }
+
+TEST_CASE("Freeze")
+{
+  Factory<TestBase> factory;
+  factory.add("d1", [] { return std::make_unique<TestDerived3>(); });
+  for (auto i = 0; i < 100; ++i) {
+    factory.add("x" + std::to_string(i), [] { return std::make_unique<TestDerived3>(); });
+  }
+
+  REQUIRE(!factory.frozen());
+  factory.freeze();
+  REQUIRE(factory.frozen());
+
+  REQUIRE(factory.create("d1")->id() == 3);
+  for (auto i = 0; i < 100; ++i) { REQUIRE(factory.create("x" + std::to_string(i))->id() == 3); }
+  REQUIRE_THROWS_AS(factory.create("d2"), std::logic_error);
+  REQUIRE_THROWS_AS(factory.add("d2", [] { return std::make_unique<TestDerived3>(); }), std::logic_error);
+}
+
+TEST_CASE("Move")
+{
+  Factory<TestBase> factory;
+  for (auto i = 0; i < 100; ++i) {
+    factory.add("x" + std::to_string(i), [] { return std::make_unique<TestDerived3>(); });
+  }
+
+  Factory<TestBase> moved(std::move(factory));
+  REQUIRE(moved.create("x0")->id() == 3);
+  REQUIRE(moved.create("x99")->id() == 3);
+
+  moved.freeze();
+  factory = std::move(moved);
+  REQUIRE(factory.frozen());
+  for (auto i = 0; i < 100; ++i) { REQUIRE(factory.create("x" + std::to_string(i))->id() == 3); }
+
+  // a moved-from factory is empty and can be reused
+  REQUIRE_THROWS_AS(moved.create("x0"), std::logic_error);
+  moved.add("x0", [] { return std::make_unique<TestDerived3>(); });
+  REQUIRE(moved.create("x0")->id() == 3);
+}
+
+std::unique_ptr<TestBase> CreateDerived3() { return std::make_unique<TestDerived3>(); }
+
+TEST_CASE("StatefulGenerators")
+{
+  class TestDerivedX : public TestBase
+  {
+  public:
+    TestDerivedX(int x) : m_x(x) {}
+    virtual int id() { return m_x; }
+
+  private:
+    int m_x;
+  };
+
+  const int small          = 4;
+  const std::string large  = "5";
+  const std::vector<int> v = {6};
+
+  Factory<TestBase> factory;
+  factory.add("fptr", &CreateDerived3);
+  factory.add("small", [&small] { return std::make_unique<TestDerivedX>(small); });
+  factory.add("large", [large] { return std::make_unique<TestDerivedX>(std::stoi(large)); });
+  factory.add("vector", [v] { return std::make_unique<TestDerivedX>(v[0]); });
+
+  REQUIRE(factory.create("fptr")->id() == 3);
+  REQUIRE(factory.create("small")->id() == 4);
+  REQUIRE(factory.create("large")->id() == 5);
+  REQUIRE(factory.create("vector")->id() == 6);
+
+  // mutable callables are supported like by std::function
+  factory.add("counter", [n = 10]() mutable { return std::make_unique<TestDerivedX>(n++); });
+  REQUIRE(factory.create("counter")->id() == 10);
+  REQUIRE(factory.create("counter")->id() == 11);
+
+  Factory<TestBase>::GeneratorT g1 = [v] { return std::make_unique<TestDerivedX>(v[0]); };
+  auto g2                          = g1;
+  auto g3                          = std::move(g1);
+  REQUIRE(!g1);
+  REQUIRE(g2()->id() == 6);
+  REQUIRE(g3()->id() == 6);
+  g2 = g3;
+  g3 = Factory<TestBase>::GeneratorT{};
+  REQUIRE(g2()->id() == 6);
+  REQUIRE_THROWS_AS(g3(), std::bad_function_call);
+}
+
+TEST_CASE("CreateShared")
+{
+  Factory<TestBase> factory;
+  factory.add("d3", [] { return std::make_unique<TestDerived3>(); });
+  factory.add(
+    "d3_shared",
+    [] { return std::make_unique<TestDerived3>(); },
+    [] {
+      struct TestDerived4 : public TestDerived3
+      {
+        virtual int id() { return 4; }
+      };
+      return std::make_shared<TestDerived4>();
+    });
+
+  // converted from unique
+  REQUIRE(factory.create_shared("d3")->id() == 3);
+
+  // dedicated shared creator
+  REQUIRE(factory.create("d3_shared")->id() == 3);
+  REQUIRE(factory.create_shared("d3_shared")->id() == 4);
+
+  REQUIRE_THROWS_AS(factory.create_shared("d5"), std::logic_error);
+}
+
+TEST_CASE("TagIds")
+{
+  using namespace ezconfig::literals;
+
+  Factory<TestBase> factory;
+  const auto id1 = factory.add("d3", [] { return std::make_unique<TestDerived3>(); });
+  const auto id2 = factory.add("d3_2", [] { return std::make_unique<TestDerived3>(); });
+  REQUIRE(!(id1 == id2));
+  REQUIRE(factory.id("d3") == id1);
+  REQUIRE(factory.id("d3_2"_tag) == id2);
+  REQUIRE_THROWS_AS(factory.id("d5"), std::logic_error);
+
+  REQUIRE(factory.create(id1)->id() == 3);
+  REQUIRE(factory.create_shared(id2)->id() == 3);
+  REQUIRE(factory.create("d3"_tag)->id() == 3);
+  REQUIRE_THROWS_AS(factory.create("d5"_tag), std::logic_error);
+  REQUIRE_THROWS_AS(factory.create(TagId{2}), std::logic_error);
+
+  // ids are stable
+  factory.freeze();
+  REQUIRE(factory.id("d3") == id1);
+  REQUIRE(factory.create(id1)->id() == 3);
+
+  static_assert("d3"_tag.hash == TagHash("d3"));
+}
+
+TEST_CASE("CreatePmr")
+{
+  std::array<std::byte, 1024> buffer;
+  std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+  const auto in_buffer = [&](const void * p) {
+    return std::less_equal<>{}(buffer.data(), p) && std::less<>{}(p, buffer.data() + buffer.size());
+  };
+
+  Factory<TestBase> factory;
+  factory.add("d3", [] { return std::make_unique<TestDerived3>(); });
+  factory.add(
+    "d3_pmr",
+    [] { return std::make_unique<TestDerived3>(); },
+    {},
+    [](std::pmr::memory_resource * r) { return MakePmrUnique<TestBase, TestDerived3>(r); });
+
+  // allocated on the heap
+  auto d3 = factory.create_pmr("d3", &resource);
+  REQUIRE(d3->id() == 3);
+  REQUIRE(!in_buffer(d3.get()));
+
+  // allocated in the buffer
+  auto d3_pmr = factory.create_pmr("d3_pmr", &resource);
+  REQUIRE(d3_pmr->id() == 3);
+  REQUIRE(in_buffer(d3_pmr.get()));
+
+  REQUIRE_THROWS_AS(factory.create_pmr("d5", &resource), std::logic_error);
+}
+
+class LazyBase
+{
+public:
+  virtual ~LazyBase() = default;
+};
+
+EZ_FACTORY_DECLARE(LazyBase);
+EZ_FACTORY_DEFINE(LazyBase);
+
+static int gLazyRegistrations = 0;
+
+EZ_GLOBAL_REGISTER(([] {
+                     ++gLazyRegistrations;
+                     EZ_FACTORY_INSTANCE(LazyBase).add("lazy1", [] { return std::make_unique<LazyBase>(); });
+                   }),
+                   Factory<LazyBase>);
+EZ_FACTORY_REGISTER(
+  "lazy2", [] { return std::make_unique<LazyBase>(); }, LazyBase);
+
+TEST_CASE("LazyRegistration")
+{
+  // nothing is registered before the factory is first used
+  REQUIRE(gLazyRegistrations == 0);
+
+  REQUIRE(EZ_FACTORY_INSTANCE(LazyBase).create("lazy1"));
+  REQUIRE(EZ_FACTORY_INSTANCE(LazyBase).create("lazy2"));
+  REQUIRE(gLazyRegistrations == 1);
+
+  REQUIRE(EZ_FACTORY_INSTANCE(LazyBase).create("lazy1"));
+  REQUIRE(gLazyRegistrations == 1);
+}
+
+class FailingBase
+{
+public:
+  virtual ~FailingBase() = default;
+};
+
+EZ_FACTORY_DECLARE(FailingBase);
+EZ_FACTORY_DEFINE(FailingBase);
+
+EZ_FACTORY_REGISTER(
+  "dup", [] { return std::make_unique<FailingBase>(); }, FailingBase);
+EZ_FACTORY_REGISTER(
+  "dup", [] { return std::make_unique<FailingBase>(); }, FailingBase);
+EZ_FACTORY_REGISTER(
+  "ok", [] { return std::make_unique<FailingBase>(); }, FailingBase);
+
+TEST_CASE("FailedRegistration")
+{
+  // the registration error is reported on every use, not only the first
+  for (auto i = 0; i < 2; ++i) {
+    try {
+      EZ_FACTORY_INSTANCE(FailingBase).create("dup");
+      FAIL("expected an exception");
+    } catch (const std::logic_error & e) {
+      REQUIRE(std::string(e.what()) == "Tag 'dup' already present");
+    }
+  }
+
+  // also for tags that were registered correctly
+  REQUIRE_THROWS_AS(gInstance<Factory<FailingBase>>().create("ok"), std::logic_error);
+}
+
+class EagerBase
+{
+public:
+  virtual ~EagerBase() = default;
+};
+
+EZ_FACTORY_DECLARE(EagerBase);
+EZ_FACTORY_DEFINE(EagerBase);
+
+static bool gEagerRegistered = false;
+
+EZ_STATIC_INVOKE([] {
+  EZ_FACTORY_INSTANCE(EagerBase).add("eager", [] { return std::make_unique<EagerBase>(); });
+  gEagerRegistered = true;
+});
+
+TEST_CASE("EagerRegistration")
+{
+  // invoked before main()
+  REQUIRE(gEagerRegistered);
+  REQUIRE(EZ_FACTORY_INSTANCE(EagerBase).create("eager"));
+}
+
+TEST_CASE("StaticStringTable")
+{
+  static constexpr StaticStringTable<3> table({"!a", "!bb", "!ccc"});
+  static_assert(table.find("!bb") == 1);
+  static_assert(table.find("!d") == 3);
+  REQUIRE(table.find(std::string("!ccc")) == 2);
+  REQUIRE(table.find("") == 3);
+
+  // larger tables with collisions
+  std::array<std::string, 200> strs;
+  std::array<std::string_view, 200> keys;
+  for (auto i = 0u; i < keys.size(); ++i) {
+    strs[i] = "key" + std::to_string(i);
+    keys[i] = strs[i];
+  }
+  const StaticStringTable<200> large(keys);
+  for (auto i = 0u; i < keys.size(); ++i) { REQUIRE(large.find(keys[i]) == i); }
+  REQUIRE(large.find("key200") == 200);
+
+  REQUIRE(StaticStringTable<0>({}).find("a") == 0);
+}
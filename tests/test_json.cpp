@@ -1,6 +1,10 @@
 // Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
 
+#include <array>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -54,9 +58,34 @@ void from_json(const nlohmann::json & j, TDerived3 & p)
   j.at("y").get_to(p.y);
 }
 
+struct TDerived4 : public TBase
+{
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  TDerived4(std::pmr::vector<int> && v, const allocator_type & alloc = {}) : x(std::move(v), alloc) {}
+
+  std::pmr::vector<int> x;
+  virtual std::string id() { return std::to_string(x.size()); }
+};
+
+struct TDerived5 : public TBase
+{
+  TDerived5(std::vector<std::unique_ptr<TBase>> && v) : x(std::move(v)) {}
+
+  std::vector<std::unique_ptr<TBase>> x;
+  virtual std::string id()
+  {
+    std::string ret;
+    for (const auto & c : x) { ret += c->id(); }
+    return ret;
+  }
+};
+
 EZ_JSON_REGISTER(TBase, "d1", TDerived1, std::string);
 EZ_JSON_REGISTER(TBase, "d2", TDerived2, int);
 EZ_JSON_REGISTER(TBase, "d3", TDerived3);
+EZ_JSON_REGISTER(TBase, "d4", TDerived4, std::pmr::vector<int>);
+EZ_JSON_REGISTER(TBase, "d5", TDerived5, std::vector<std::unique_ptr<TBase>>);
 
 EZ_FACTORY_REGISTER(
   "hello", [](const nlohmann::json &) { return std::unique_ptr<TBase>{}; }, TBase, const nlohmann::json &);
@@ -148,3 +177,87 @@ TEST_CASE("JsonAsVector")
   REQUIRE(vec[2]->id() == "4321234");
   REQUIRE(vec[3]->id() == "27");
 }
+
+TEST_CASE("JsonCreatePmr")
+{
+  std::array<std::byte, 1024> buffer;
+  std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+  auto d3 = json::Create<TBase>(nlohmann::json::parse(R"({"d3": {"x": 1, "y": 2}})"), &resource);
+  REQUIRE(d3->id() == "3");
+
+  // the vector member is allocated from the resource as well
+  auto d4 = json::Create<TBase>(nlohmann::json::parse(R"({"d4": [1, 2, 3, 4]})"), &resource);
+  REQUIRE(d4->id() == "4");
+  const void * data = static_cast<const TDerived4 *>(d4.get())->x.data();
+  REQUIRE(std::less_equal<const void *>{}(buffer.data(), data));
+  REQUIRE(std::less<const void *>{}(data, buffer.data() + buffer.size()));
+
+  REQUIRE_THROWS(json::Create<TBase>(nlohmann::json::parse(R"({"d6": 1})"), &resource));
+}
+
+TEST_CASE("JsonCreateParallel")
+{
+  ThreadPool pool(2);
+
+  const auto vec = json::CreateParallel<TBase>(nlohmann::json::parse(R"([{"d1": "a"}, {"d2": 2}])"), pool);
+  REQUIRE(vec.size() == 2);
+  REQUIRE(vec[0]->id() == "a");
+  REQUIRE(vec[1]->id() == "2");
+
+  const auto map =
+    json::CreateMapParallel<TBase>(nlohmann::json::parse(R"({"x": {"d1": "a"}, "y": {"d2": 2}})"), pool);
+  REQUIRE(map.size() == 2);
+  REQUIRE(map.at("x")->id() == "a");
+  REQUIRE(map.at("y")->id() == "2");
+
+  REQUIRE_THROWS(json::CreateParallel<TBase>(nlohmann::json::parse(R"([{"d1": "a"}, {"d6": 2}])"), pool));
+  REQUIRE_THROWS(json::CreateParallel<TBase>(nlohmann::json::parse(R"({"d1": "a"})"), pool));
+}
+
+TEST_CASE("JsonSaxCreate")
+{
+  REQUIRE(json::SaxCreate<TBase>(std::string(R"({"d1": "hello"})"))->id() == "hello");
+  REQUIRE(json::SaxCreate<TBase>(std::string(R"({"d2": 123})"))->id() == "123");
+  REQUIRE(json::SaxCreate<TBase>(std::string(R"({"d3": {"x": 1, "y": 2}})"))->id() == "3");
+  REQUIRE(json::SaxCreate<TBase>(std::string(R"({"d4": [1, 2, 3]})"))->id() == "3");
+
+  // nested objects are streamed as well
+  const std::string nested = R"({"d5": [{"d1": "a"}, {"d5": [{"d2": 1}, {"d3": {"x": 1, "y": 1}}]}, {"d1": "b"}]})";
+  REQUIRE(json::SaxCreate<TBase>(nested)->id() == "a12b");
+  REQUIRE(json::SaxCreate<TBase>(nested)->id() == json::Create<TBase>(nlohmann::json::parse(nested))->id());
+
+  // tags registered directly with the json factory
+  REQUIRE(json::SaxCreate<TBase>(std::string(R"({"hello": {"a": [1, 2]}})")) == nullptr);
+
+  std::istringstream stream(R"({"d1": "from stream"})");
+  REQUIRE(json::SaxCreate<TBase>(stream)->id() == "from stream");
+
+  REQUIRE(json::SaxGet<std::vector<double>>(std::string("[1, 2.5, -3]")) == std::vector<double>{1, 2.5, -3});
+  const std::string dom = R"({"a": [1, {"b": null}], "c": "d"})";
+  REQUIRE(json::SaxGet<nlohmann::json>(dom) == nlohmann::json::parse(dom));
+
+  REQUIRE_THROWS(json::SaxCreate<TBase>(std::string(R"({"d1": "hello", "d2": 123})")));
+  REQUIRE_THROWS(json::SaxCreate<TBase>(std::string(R"(["d1", "hello"])")));
+  REQUIRE_THROWS(json::SaxCreate<TBase>(std::string(R"({"d6": 1})")));
+  REQUIRE_THROWS(json::SaxCreate<TBase>(std::string(R"({"d2": "hello"})")));
+  REQUIRE_THROWS_AS(json::SaxCreate<TBase>(std::string(R"({"d1": "hello")")), nlohmann::json::parse_error);
+}
+
+TEST_CASE("JsonLoadFile")
+{
+  const auto path = std::filesystem::temp_directory_path() / "ezconfig_test_load_file.json";
+  std::ofstream(path) << R"({"d3": {"x": 1, "y": 2}})";
+
+  LoadStats stats;
+  auto d3 = json::LoadFile<TBase>(path, &stats);
+  REQUIRE(d3->id() == "3");
+  REQUIRE(stats.bytes == 24);
+  REQUIRE(stats.mapped);
+
+  std::ofstream(path, std::ios::trunc) << R"({"d3": {"x": 1, "y": 2})";
+  REQUIRE_THROWS(json::LoadFile<TBase>(path));
+
+  std::filesystem::remove(path);
+  REQUIRE_THROWS_AS(json::LoadFile<TBase>(path), std::system_error);
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/factory.hpp"
+
+using namespace ezconfig;
+using namespace std::chrono_literals;
+
+class MBase
+{
+public:
+  virtual ~MBase() = default;
+};
+
+TEST_CASE("Metrics")
+{
+  Factory<MBase, int> factory;
+  factory.add("fast", [](int) { return std::make_unique<MBase>(); });
+  factory.add("slow", [](int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    return std::make_unique<MBase>();
+  });
+  factory.add("fail", [](int) -> std::unique_ptr<MBase> { throw std::runtime_error("fail"); });
+
+  std::vector<std::jthread> threads;
+  for (auto t = 0u; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (auto i = 0u; i < 25; ++i) { factory.create("fast", 0); }
+    });
+  }
+  threads.clear();
+
+  for (auto i = 0u; i < 10; ++i) { factory.create_shared("slow", 1); }
+  factory.create("slow", 20);
+  REQUIRE_THROWS_AS(factory.create("fail", 0), std::runtime_error);
+
+  const auto metrics = factory.metrics();
+  REQUIRE(metrics.size() == 3);
+
+  REQUIRE(metrics[0].tag == "fast");
+  REQUIRE(metrics[0].count == 100);
+  REQUIRE(metrics[0].failures == 0);
+
+  REQUIRE(metrics[1].tag == "slow");
+  REQUIRE(metrics[1].count == 11);
+  REQUIRE(metrics[1].total >= 30ms);
+  REQUIRE(metrics[1].p50 >= 1ms * 0.85);
+  REQUIRE(metrics[1].p50 < 20ms);
+  REQUIRE(metrics[1].p99 >= 20ms * 0.85);
+  REQUIRE(metrics[1].max >= 20ms);
+  REQUIRE(metrics[1].p99 <= metrics[1].max);
+
+  REQUIRE(metrics[2].tag == "fail");
+  REQUIRE(metrics[2].count == 1);
+  REQUIRE(metrics[2].failures == 1);
+
+  const auto json = MetricsToJson(metrics);
+  REQUIRE(json.starts_with(R"([{"tag":"fast","count":100,"failures":0,"total_ns":)"));
+  REQUIRE(json.find(R"({"tag":"fail","count":1,"failures":1,)") != std::string::npos);
+  REQUIRE(json.ends_with("}]"));
+}
@@ -0,0 +1,97 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/yaml.hpp"
+
+using namespace ezconfig;
+
+class PBase
+{
+public:
+  virtual ~PBase()                = default;
+  virtual std::string id() const = 0;
+};
+
+EZ_YAML_DECLARE(PBase);
+EZ_YAML_DEFINE(PBase);
+
+class PDerived : public PBase
+{
+public:
+  explicit PDerived(std::string x) : m_x(std::move(x))
+  {
+    if (m_x.starts_with("fail")) { throw std::runtime_error(m_x); }
+  }
+
+  std::string id() const override { return m_x; }
+
+private:
+  std::string m_x;
+};
+
+EZ_YAML_REGISTER(PBase, "!p", PDerived, std::string);
+
+TEST_CASE("ParallelFor")
+{
+  ThreadPool pool(4);
+
+  std::vector<std::atomic<int>> counts(1000);
+  ParallelFor(pool, counts.size(), [&](std::size_t i) { ++counts[i]; });
+  for (const auto & count : counts) { REQUIRE(count == 1); }
+
+  // nested calls on the same pool
+  std::atomic<int> total{0};
+  ParallelFor(pool, 10, [&](std::size_t) { ParallelFor(pool, 10, [&](std::size_t) { ++total; }); });
+  REQUIRE(total == 100);
+
+  // the exception with the lowest index is rethrown
+  const auto f = [&] {
+    ParallelFor(pool, 100, [](std::size_t i) {
+      if (i % 10 == 7) { throw std::runtime_error(std::to_string(i)); }
+    });
+  };
+  for (auto k = 0u; k < 10; ++k) {
+    try {
+      f();
+      FAIL();
+    } catch (const std::runtime_error & e) {
+      REQUIRE(std::string(e.what()) == "7");
+    }
+  }
+}
+
+TEST_CASE("YamlCreateParallel")
+{
+  ThreadPool pool(4);
+
+  std::string yaml_str;
+  for (auto i = 0u; i < 100; ++i) { yaml_str += "- !p " + std::to_string(i) + "\n"; }
+  const auto objs = yaml::CreateParallel<PBase>(YAML::Load(yaml_str), pool);
+  REQUIRE(objs.size() == 100);
+  for (auto i = 0u; i < 100; ++i) { REQUIRE(objs[i]->id() == std::to_string(i)); }
+
+  // same result with the sequential executor
+  const auto seq = yaml::CreateParallel<PBase>(YAML::Load(yaml_str), SequentialExecutor{});
+  REQUIRE(seq.size() == 100);
+
+  const auto map = yaml::CreateMapParallel<PBase>(YAML::Load("{a: !p 1, b: !p 2}"), pool);
+  REQUIRE(map.size() == 2);
+  REQUIRE(map.at("a")->id() == "1");
+  REQUIRE(map.at("b")->id() == "2");
+
+  try {
+    yaml::CreateParallel<PBase>(YAML::Load("[!p ok, !p fail1, !p ok, !p fail2]"), pool);
+    FAIL();
+  } catch (const std::runtime_error & e) {
+    REQUIRE(std::string(e.what()) == "fail1");
+  }
+
+  REQUIRE_THROWS_AS(yaml::CreateParallel<PBase>(YAML::Load("!p 1"), pool), YAML::ParserException);
+  REQUIRE_THROWS_AS(yaml::CreateMapParallel<PBase>(YAML::Load("[!p 1]"), pool), YAML::ParserException);
+}
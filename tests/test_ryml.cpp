@@ -0,0 +1,122 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/ryml.hpp"
+
+class TBase
+{
+public:
+  virtual ~TBase()         = default;
+  virtual std::string id() = 0;
+};
+
+EZ_RYML_DECLARE(TBase);
+EZ_RYML_DEFINE(TBase);
+
+class TDerived1 : public TBase
+{
+public:
+  TDerived1(std::string x) : m_x(x) {}
+
+  virtual std::string id() { return m_x; }
+
+private:
+  std::string m_x;
+};
+
+class TDerived2 : public TBase
+{
+public:
+  TDerived2(int x) : m_x(x) {}
+
+  virtual std::string id() { return std::to_string(m_x); }
+
+private:
+  int m_x;
+};
+
+struct TDerived3 : public TBase
+{
+  int x{};
+  int y{};
+  virtual std::string id() { return std::to_string(x + y); }
+};
+
+bool read(c4::yml::ConstNodeRef const & n, TDerived3 * obj)
+{
+  obj->x = ezconfig::ryml::Get<int>(n, "x");
+  obj->y = ezconfig::ryml::Get<int>(n, "y");
+  return true;
+}
+
+struct NotReadable
+{};
+
+static_assert(ezconfig::ryml::RymlReadable<int>);
+static_assert(ezconfig::ryml::RymlReadable<std::string>);
+static_assert(ezconfig::ryml::RymlReadable<std::vector<int>>);
+static_assert(ezconfig::ryml::RymlReadable<TDerived3>);
+static_assert(ezconfig::ryml::RymlReadable<std::unique_ptr<TBase>>);
+static_assert(!ezconfig::ryml::RymlReadable<NotReadable>);
+
+EZ_RYML_REGISTER(TBase, "!d1", TDerived1, std::string);
+EZ_RYML_REGISTER(TBase, "!d2", TDerived2, int);
+EZ_RYML_REGISTER(TBase, "!d3", TDerived3);
+
+static ryml::Tree Parse(const std::string & str) { return ryml::parse_in_arena(ryml::to_csubstr(str)); }
+
+TEST_CASE("RymlCreate")
+{
+  const auto d1 = Parse("!d1 hello");
+  REQUIRE(ezconfig::ryml::Create<TBase>(d1.crootref())->id() == "hello");
+
+  const auto d2 = Parse("!d2 123");
+  REQUIRE(ezconfig::ryml::Create<TBase>(d2.crootref())->id() == "123");
+
+  const auto d3 = Parse(R"(
+!d3
+x: 1
+y: 2
+)");
+  REQUIRE(ezconfig::ryml::Create<TBase>(d3.crootref())->id() == "3");
+  REQUIRE(ezconfig::ryml::CreateShared<TBase>(d3.crootref())->id() == "3");
+}
+
+TEST_CASE("RymlContainers")
+{
+  const auto seq = Parse(R"(
+- !d1 hello
+- !d2 5
+- !d3 {x: 1, y: 3}
+)");
+  const auto vec = ezconfig::ryml::Get<std::vector<std::unique_ptr<TBase>>>(seq.crootref());
+  REQUIRE(vec.size() == 3);
+  REQUIRE(vec[0]->id() == "hello");
+  REQUIRE(vec[1]->id() == "5");
+  REQUIRE(vec[2]->id() == "4");
+
+  const auto map = Parse(R"(
+a: !d1 hello
+b: !d2 5
+)");
+  const auto objs = ezconfig::ryml::Get<std::map<std::string, std::shared_ptr<TBase>>>(map.crootref());
+  REQUIRE(objs.size() == 2);
+  REQUIRE(objs.at("a")->id() == "hello");
+  REQUIRE(objs.at("b")->id() == "5");
+}
+
+TEST_CASE("RymlErrors")
+{
+  REQUIRE_THROWS(ezconfig::ryml::Create<TBase>(Parse("hello").crootref()));
+  REQUIRE_THROWS(ezconfig::ryml::Create<TBase>(Parse("!d5 hello").crootref()));
+  REQUIRE_THROWS(ezconfig::ryml::Create<TBase>(Parse("!d2 hello").crootref()));
+  REQUIRE_THROWS(ezconfig::ryml::Create<TBase>(Parse("!d3 {x: 1}").crootref()));
+
+  static_assert(ezconfig::ryml::IsValidTag("!tag"));
+  static_assert(!ezconfig::ryml::IsValidTag("tag"));
+}
@@ -0,0 +1,176 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <boost/hana/adapt_struct.hpp>
+#include <boost/hana/tuple.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "ezconfig/ryml_types/eigen.hpp"
+#include "ezconfig/ryml_types/enum.hpp"
+#include "ezconfig/ryml_types/hana.hpp"
+#include "ezconfig/ryml_types/smooth.hpp"
+#include "ezconfig/ryml_types/stl.hpp"
+
+using ezconfig::ryml::Get;
+
+static ryml::Tree Parse(const std::string & str) { return ryml::parse_in_arena(ryml::to_csubstr(str)); }
+
+template<typename T>
+static T Load(const std::string & str)
+{
+  return Get<T>(Parse(str).crootref());
+}
+
+TEST_CASE("ryml_std")
+{
+  REQUIRE(Load<std::optional<int>>("null") == std::nullopt);
+  REQUIRE(Load<std::optional<int>>("~") == std::nullopt);
+  REQUIRE(Load<std::optional<int>>("123") == 123);
+
+  const auto map = Load<std::unordered_map<std::string, double>>("{obj1: 1.25, obj2: 2.25}");
+  REQUIRE(map.size() == 2);
+  REQUIRE(map.at("obj2") == 2.25);
+
+  REQUIRE(Load<std::filesystem::path>("my/file") == std::filesystem::path("my/file"));
+}
+
+TEST_CASE("ryml_chrono")
+{
+  using namespace std::chrono_literals;
+
+  REQUIRE(Load<std::chrono::nanoseconds>("5ns") == 5ns);
+  REQUIRE(Load<std::chrono::microseconds>("5us") == 5us);
+  REQUIRE(Load<std::chrono::milliseconds>("5ms") == 5ms);
+  REQUIRE(Load<std::chrono::seconds>("5s") == 5s);
+  REQUIRE(Load<std::chrono::minutes>("5m") == 300s);
+  REQUIRE(Load<std::chrono::nanoseconds>("5h") == 5h);
+  REQUIRE_THROWS(Load<std::chrono::seconds>("5"));
+  REQUIRE(Load<std::chrono::seconds>("1m30s") == 90s);
+  REQUIRE(Load<std::chrono::duration<double>>("1.5s").count() == 1.5);
+  REQUIRE(Load<std::chrono::duration<double>>("99999999999999999999s").count() == 1e20);
+  REQUIRE_THROWS(Load<std::chrono::nanoseconds>("3000000h"));
+}
+
+using MyVariant = std::variant<double, std::string, int>;
+
+template<>
+struct ezconfig::variant_hana_maps<MyVariant>
+{
+  static constexpr auto value = boost::hana::make_tuple(
+    boost::hana::make_pair("!double", boost::hana::type_c<double>),
+    boost::hana::make_pair("!int", boost::hana::type_c<int>),
+    boost::hana::make_pair("!string", boost::hana::type_c<std::string>));
+};
+
+struct MyStruct
+{
+  MyVariant member1;
+  std::vector<MyVariant> member2;
+  std::optional<std::string> member3;
+};
+
+BOOST_HANA_ADAPT_STRUCT(MyStruct, member1, member2, member3);
+
+struct MyStrictStruct
+{
+  int a;
+  double b;
+};
+
+BOOST_HANA_ADAPT_STRUCT(MyStrictStruct, a, b);
+
+template<>
+struct ezconfig::hana_strict_keys<MyStrictStruct> : std::true_type
+{};
+
+TEST_CASE("ryml_hana")
+{
+  const auto x = Load<MyVariant>("!double 3.14");
+  REQUIRE(x.index() == 0);
+  REQUIRE_THAT(std::get<double>(x), Catch::Matchers::WithinRel(3.14));
+  REQUIRE(Load<MyVariant>("!int 3") == MyVariant(3));
+  REQUIRE_THROWS(Load<MyVariant>("!undefined 3.14"));
+
+  const auto data = Load<MyStruct>(R"(
+member1: !string hello
+member2:
+  - !int 5
+  - !int 6
+member3: null
+)");
+  REQUIRE(data.member1 == MyVariant("hello"));
+  REQUIRE(data.member2 == std::vector<MyVariant>{5, 6});
+  REQUIRE(data.member3 == std::nullopt);
+
+  // unknown keys are ignored
+  REQUIRE(Load<MyStruct>("{member3: abc, member1: !int 1, unknown: 2, member2: []}").member3 == "abc");
+  REQUIRE_THROWS(Load<MyStruct>("{member1: !int 1, member2: []}"));
+  REQUIRE_THROWS(Load<MyStrictStruct>("{a: 1, b: 2.5, c: 3}"));
+  REQUIRE(Load<MyStrictStruct>("{b: 2.5, a: 1}").a == 1);
+}
+
+TEST_CASE("ryml_eigen")
+{
+  REQUIRE(Load<Eigen::Vector3d>("[1., 2., 3.]").isApprox(Eigen::Vector3d{1, 2, 3}));
+  REQUIRE(Load<Eigen::Vector3d>("{x: 1., y: 2., z: 3.}").isApprox(Eigen::Vector3d{1, 2, 3}));
+  REQUIRE(Load<Eigen::VectorXd>("{x: 1., y: 2.}").isApprox(Eigen::Vector2d{1, 2}));
+  REQUIRE(Load<Eigen::VectorXd>("[1., 2., 3., 4.]").isApprox(Eigen::Vector4d{1, 2, 3, 4}));
+  REQUIRE_THROWS(Load<Eigen::Vector3d>("[1., 2., 3., 4.]"));
+
+  REQUIRE(Load<Eigen::Matrix<double, 2, 3>>("[[1., 2., 3.], [4., 5., 6.]]")
+            .isApprox(Eigen::MatrixXd{{1, 2, 3}, {4, 5, 6}}));
+  REQUIRE(Load<Eigen::MatrixXd>("[[1., 2., 3.], [4., 5., 6.]]").isApprox(Eigen::MatrixXd{{1, 2, 3}, {4, 5, 6}}));
+  REQUIRE_THROWS(Load<Eigen::MatrixXd>("[]"));
+  REQUIRE_THROWS(Load<Eigen::MatrixXd>("[[1., 2., 3.], [4., 5.]]"));
+
+  REQUIRE(Load<Eigen::Quaterniond>("{w: 0., x: 0., y: 0., z: 1.}").isApprox(Eigen::Quaterniond{0, 0, 0, 1}));
+  REQUIRE(Load<Eigen::Quaterniond>("{qw: 0., qx: 0., qy: 0., qz: 1.}").isApprox(Eigen::Quaterniond{0, 0, 0, 1}));
+}
+
+TEST_CASE("ryml_smooth")
+{
+  const auto pose_str = R"(
+x: 1.
+y: -1.
+z: 1.
+qw: 0.
+qx: 0.
+qy: 0.
+qz: 1.
+)";
+
+  REQUIRE(Load<smooth::SO3d>("{w: 0., x: 0., y: 0., z: 1.}").isApprox(smooth::SO3d(Eigen::Quaterniond{0, 0, 0, 1})));
+  REQUIRE(Load<smooth::SE3d>(pose_str).isApprox(
+    smooth::SE3d(smooth::SO3d{Eigen::Quaterniond{0, 0, 0, 1}}, Eigen::Vector3d{1, -1, 1})));
+}
+
+enum class TestEnum {
+  VALUE_1,
+  VALUE_2,
+  VALUE_3,
+};
+
+TEST_CASE("ryml_enum")
+{
+  REQUIRE(Load<TestEnum>("VALUE_1") == TestEnum::VALUE_1);
+  REQUIRE(Load<TestEnum>("VALUE_3") == TestEnum::VALUE_3);
+  REQUIRE_THROWS(Load<TestEnum>("VALUE_4"));
+  REQUIRE_THROWS(Load<TestEnum>("value_1"));
+}
+
+enum class TestCaseEnum {
+  Red,
+  DarkBlue = 10,
+};
+
+template<>
+struct ezconfig::enum_case_insensitive<TestCaseEnum> : std::true_type
+{};
+
+TEST_CASE("ryml_enum_case_insensitive")
+{
+  REQUIRE(Load<TestCaseEnum>("RED") == TestCaseEnum::Red);
+  REQUIRE(Load<TestCaseEnum>("darkBlue") == TestCaseEnum::DarkBlue);
+  REQUIRE_THROWS(Load<TestCaseEnum>("blue"));
+  REQUIRE(Load<TestCaseEnum>("5") == static_cast<TestCaseEnum>(5));
+}
@@ -0,0 +1,120 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/simdjson.hpp"
+
+class TBase
+{
+public:
+  virtual ~TBase()         = default;
+  virtual std::string id() = 0;
+};
+
+EZ_SIMDJSON_DECLARE(TBase);
+EZ_SIMDJSON_DEFINE(TBase);
+
+class TDerived1 : public TBase
+{
+public:
+  TDerived1(std::string x) : m_x(x) {}
+
+  virtual std::string id() { return m_x; }
+
+private:
+  std::string m_x;
+};
+
+class TDerived2 : public TBase
+{
+public:
+  TDerived2(int x) : m_x(x) {}
+
+  virtual std::string id() { return std::to_string(m_x); }
+
+private:
+  int m_x;
+};
+
+struct TDerived3 : public TBase
+{
+  int x{};
+  int y{};
+  virtual std::string id() { return std::to_string(x + y); }
+};
+
+// conversion from json directly to Derived3
+template<>
+struct ezconfig::simdjson::Decoder<TDerived3>
+{
+  static TDerived3 decode(::simdjson::ondemand::value v)
+  {
+    TDerived3 ret;
+    auto obj = v.get_object();
+    ret.x    = Decode<int>(obj["x"]);
+    ret.y    = Decode<int>(obj["y"]);
+    return ret;
+  }
+};
+
+struct TDerived4 : public TBase
+{
+  TDerived4(std::vector<std::unique_ptr<TBase>> && v) : x(std::move(v)) {}
+
+  std::vector<std::unique_ptr<TBase>> x;
+  virtual std::string id()
+  {
+    std::string ret;
+    for (const auto & c : x) { ret += c->id(); }
+    return ret;
+  }
+};
+
+EZ_SIMDJSON_REGISTER(TBase, "d1", TDerived1, std::string);
+EZ_SIMDJSON_REGISTER(TBase, "d2", TDerived2, int);
+EZ_SIMDJSON_REGISTER(TBase, "d3", TDerived3);
+EZ_SIMDJSON_REGISTER(TBase, "d4", TDerived4, std::vector<std::unique_ptr<TBase>>);
+
+TEST_CASE("SimdjsonCreate")
+{
+  using ezconfig::simdjson::Get;
+
+  REQUIRE(Get<std::unique_ptr<TBase>>(R"({"d1": "hello"})"_padded)->id() == "hello");
+  REQUIRE(Get<std::unique_ptr<TBase>>(R"({"d2": 123})"_padded)->id() == "123");
+  REQUIRE(Get<std::unique_ptr<TBase>>(R"({"d3": {"y": 2, "x": 1}})"_padded)->id() == "3");
+  REQUIRE(Get<std::shared_ptr<TBase>>(R"({"d1": "hello"})"_padded)->id() == "hello");
+
+  const auto nested = R"({"d4": [{"d1": "a"}, {"d4": [{"d2": 1}, {"d3": {"x": 1, "y": 1}}]}, {"d1": "b"}]})"_padded;
+  REQUIRE(Get<std::unique_ptr<TBase>>(nested)->id() == "a12b");
+
+  simdjson::ondemand::parser parser;
+  const auto map = Get<std::map<std::string, std::unique_ptr<TBase>>>(parser, R"({"a": {"d1": "x"}})"_padded);
+  REQUIRE(map.at("a")->id() == "x");
+  const auto vec = Get<std::vector<std::shared_ptr<TBase>>>(parser, R"([{"d1": "x"}, {"d2": 2}])"_padded);
+  REQUIRE(vec.size() == 2);
+  REQUIRE(vec[1]->id() == "2");
+
+  const auto json = R"({"d2": 5})"_padded;
+  auto doc        = parser.iterate(json);
+  REQUIRE(ezconfig::simdjson::Create<TBase>(doc.get_value())->id() == "5");
+}
+
+TEST_CASE("SimdjsonErrors")
+{
+  using ezconfig::simdjson::Get;
+
+  REQUIRE_THROWS(Get<std::unique_ptr<TBase>>(R"({"d1": "hello", "d2": 123})"_padded));
+  REQUIRE_THROWS(Get<std::unique_ptr<TBase>>(R"({})"_padded));
+  REQUIRE_THROWS(Get<std::unique_ptr<TBase>>(R"(["d1", "hello"])"_padded));
+  REQUIRE_THROWS(Get<std::unique_ptr<TBase>>(R"({"d5": 1})"_padded));
+  REQUIRE_THROWS_AS(Get<std::unique_ptr<TBase>>(R"({"d2": "hello"})"_padded), simdjson::simdjson_error);
+  REQUIRE_THROWS_AS(Get<std::unique_ptr<TBase>>(R"({"d2": 5000000000})"_padded), std::out_of_range);
+  REQUIRE_THROWS(Get<std::unique_ptr<TBase>>(R"({"d1": "hello"} 1)"_padded));
+  REQUIRE_THROWS_AS(
+    (Get<std::map<std::string, std::unique_ptr<TBase>>>(R"({"a": {"d1": "x"}, "a": {"d1": "y"}})"_padded)),
+    std::logic_error);
+}
@@ -0,0 +1,330 @@
+// Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "ezconfig/yaml_snapshot.hpp"
+#include "ezconfig/yaml_types/stl.hpp"
+
+using namespace ezconfig;
+
+class TBase
+{
+public:
+  virtual ~TBase()         = default;
+  virtual std::string id() = 0;
+};
+
+EZ_YAML_SNAPSHOT_DECLARE(TBase);
+EZ_YAML_SNAPSHOT_DEFINE(TBase);
+
+class TDerived1 : public TBase
+{
+public:
+  TDerived1(std::string x) : m_x(x) {}
+
+  virtual std::string id() { return m_x; }
+
+private:
+  std::string m_x;
+};
+
+struct TDerived2 : public TBase
+{
+  TDerived2(std::map<std::string, std::unique_ptr<TBase>> && v) : x(std::move(v)) {}
+
+  std::map<std::string, std::unique_ptr<TBase>> x;
+  virtual std::string id()
+  {
+    std::string ret;
+    for (const auto & [k, v] : x) { ret += k + "=" + v->id() + ","; }
+    return ret;
+  }
+};
+
+struct TDerived3 : public TBase
+{
+  int x{};
+  std::vector<double> y{};
+  std::optional<std::shared_ptr<TBase>> z{};
+  virtual std::string id() { return std::to_string(x) + " " + std::to_string(y.size()) + (z ? (*z)->id() : ""); }
+};
+
+// not serializable
+struct TDerived4 : public TBase
+{
+  int x{};
+  virtual std::string id() { return std::to_string(x); }
+};
+
+static int g_decoded = 0;
+
+template<>
+struct YAML::convert<TDerived3>
+{
+  static bool decode(const YAML::Node & node, TDerived3 & p)
+  {
+    ++g_decoded;
+    p.x = node["x"].as<int>();
+    p.y = node["y"].as<std::vector<double>>();
+    if (node["z"]) { p.z = node["z"].as<std::shared_ptr<TBase>>(); }
+    return true;
+  }
+};
+
+template<>
+struct YAML::convert<TDerived4>
+{
+  static bool decode(const YAML::Node & node, TDerived4 & p)
+  {
+    p.x = node.as<int>();
+    return true;
+  }
+};
+
+template<>
+struct ezconfig::Serializer<TDerived3>
+{
+  static std::uint64_t schema()
+  {
+    return SchemaHashOf<int, std::vector<double>, std::optional<std::shared_ptr<TBase>>>();
+  }
+
+  static void write(SnapshotWriter & w, const TDerived3 & p)
+  {
+    w.write(p.x);
+    w.write(p.y);
+    w.write(p.z);
+  }
+
+  static TDerived3 read(SnapshotReader & r)
+  {
+    TDerived3 ret;
+    ret.x = r.read<int>();
+    ret.y = r.read<std::vector<double>>();
+    ret.z = r.read<std::optional<std::shared_ptr<TBase>>>();
+    return ret;
+  }
+};
+
+struct TNested
+{
+  int a{};
+};
+
+struct TDerived5 : public TBase
+{
+  std::vector<TNested> v{};
+  virtual std::string id()
+  {
+    std::string ret;
+    for (const auto & x : v) { ret += std::to_string(x.a) + ","; }
+    return ret;
+  }
+};
+
+template<>
+struct YAML::convert<TDerived5>
+{
+  static bool decode(const YAML::Node & node, TDerived5 & p)
+  {
+    for (const auto & x : node) { p.v.push_back(TNested{x.as<int>()}); }
+    return true;
+  }
+};
+
+template<>
+struct ezconfig::Serializer<TNested>
+{
+  // not constexpr so that the test can change it
+  static inline std::uint32_t version = 1;
+
+  static void write(SnapshotWriter & w, const TNested & p) { w.write(p.a); }
+
+  static TNested read(SnapshotReader & r) { return TNested{r.read<int>()}; }
+};
+
+template<>
+struct ezconfig::Serializer<TDerived5>
+{
+  static std::uint64_t schema() { return SchemaHashOf<std::vector<TNested>>(); }
+
+  static void write(SnapshotWriter & w, const TDerived5 & p) { w.write(p.v); }
+
+  static TDerived5 read(SnapshotReader & r)
+  {
+    TDerived5 ret;
+    ret.v = r.read<std::vector<TNested>>();
+    return ret;
+  }
+};
+
+EZ_YAML_SNAPSHOT_REGISTER(TBase, "!d1", TDerived1, std::string);
+EZ_YAML_SNAPSHOT_REGISTER(TBase, "!d2", TDerived2, std::map<std::string, std::unique_ptr<TBase>>);
+EZ_YAML_SNAPSHOT_REGISTER(TBase, "!d3", TDerived3);
+EZ_YAML_REGISTER(TBase, "!d4", TDerived4);
+EZ_YAML_SNAPSHOT_REGISTER(TBase, "!d5", TDerived5);
+
+TEST_CASE("SnapshotSerializer")
+{
+  SnapshotWriter w;
+  w.write(std::string("hello"));
+  w.write(std::vector<std::string>{"a", "bc"});
+  w.write(std::map<int, std::optional<double>>{{1, 1.5}, {2, std::nullopt}});
+  w.write(std::vector<bool>{true, false, true});
+  w.write(std::pair<float, std::array<int, 2>>{0.5f, {3, 4}});
+
+  SnapshotReader r(w.data());
+  REQUIRE(r.read<std::string>() == "hello");
+  REQUIRE(r.read<std::vector<std::string>>() == std::vector<std::string>{"a", "bc"});
+  REQUIRE(r.read<std::map<int, std::optional<double>>>() == std::map<int, std::optional<double>>{{1, 1.5}, {2, {}}});
+  REQUIRE(r.read<std::vector<bool>>() == std::vector<bool>{true, false, true});
+  REQUIRE(r.read<std::pair<float, std::array<int, 2>>>() == std::pair<float, std::array<int, 2>>{0.5f, {3, 4}});
+  REQUIRE(r.at_end());
+  REQUIRE_THROWS(r.read<int>());
+
+  // sizes are checked before allocating
+  SnapshotWriter w2;
+  w2.write(std::uint64_t{1} << 60);
+  SnapshotReader r2(w2.data());
+  REQUIRE_THROWS(r2.read<std::vector<double>>());
+
+  REQUIRE(HashBytes("hello") != HashBytes("hellp"));
+  REQUIRE(HashBytes("hello world!") != HashBytes("hello world?"));
+  REQUIRE(SchemaHash<TDerived3>() != SchemaHash<std::string>());
+}
+
+TEST_CASE("SnapshotLoadFileCached")
+{
+  const auto dir      = std::filesystem::temp_directory_path();
+  const auto path     = dir / "ezconfig_test_snapshot.yaml";
+  const auto snapshot = dir / "ezconfig_test_snapshot.bin";
+  std::filesystem::remove(snapshot);
+
+  std::ofstream(path) << R"(
+!d2
+a: !d1 hello
+b: !d3
+  x: 1
+  y: [1, 2, 3]
+  z: !d3
+    x: 2
+    y: []
+)";
+
+  g_decoded = 0;
+  LoadStats stats;
+  const auto expected = yaml::LoadFileCached<TBase>(path, snapshot, &stats)->id();
+  REQUIRE(expected == "a=hello,b=1 32 0,");
+  REQUIRE(!stats.snapshot);
+  REQUIRE(g_decoded == 2);
+  REQUIRE(std::filesystem::exists(snapshot));
+
+  // second load does not decode any yaml
+  REQUIRE(yaml::LoadFileCached<TBase>(path, snapshot, &stats)->id() == expected);
+  REQUIRE(stats.snapshot);
+  REQUIRE(stats.parse.count() == 0);
+  REQUIRE(g_decoded == 2);
+
+  // changed file
+  std::ofstream(path) << "!d2\na: !d1 holla\n";
+  REQUIRE(yaml::LoadFileCached<TBase>(path, snapshot, &stats)->id() == "a=holla,");
+  REQUIRE(!stats.snapshot);
+  REQUIRE(yaml::LoadFileCached<TBase>(path, snapshot, &stats)->id() == "a=holla,");
+  REQUIRE(stats.snapshot);
+
+  // corrupt snapshot payload
+  {
+    std::fstream f(snapshot, std::ios::binary | std::ios::in | std::ios::out);
+    f.seekp(-1, std::ios::end);
+    f.put('x');
+  }
+  REQUIRE(yaml::LoadFileCached<TBase>(path, snapshot, &stats)->id() == "a=holla,");
+  REQUIRE(!stats.snapshot);
+  REQUIRE(yaml::LoadFileCached<TBase>(path, snapshot, &stats)->id() == "a=holla,");
+  REQUIRE(stats.snapshot);
+
+  // truncated snapshot
+  const auto size = std::filesystem::file_size(snapshot);
+  std::filesystem::resize_file(snapshot, size - 1);
+  REQUIRE(yaml::LoadFileCached<TBase>(path, snapshot, &stats)->id() == "a=holla,");
+  REQUIRE(!stats.snapshot);
+  REQUIRE(std::filesystem::file_size(snapshot) == size);
+
+  // not serializable, no snapshot is written
+  std::filesystem::remove(snapshot);
+  std::ofstream(path) << "!d2\na: !d4 5\n";
+  REQUIRE(yaml::LoadFileCached<TBase>(path, snapshot, &stats)->id() == "a=5,");
+  REQUIRE(!stats.snapshot);
+  REQUIRE(!std::filesystem::exists(snapshot));
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("SnapshotSchema")
+{
+  SnapshotWriter w;
+  w.write_string("!d1");
+  w.write(SchemaHash<std::string>());
+  w.write(std::string("hello"));
+  SnapshotReader r(w.data());
+  REQUIRE(r.read<std::unique_ptr<TBase>>()->id() == "hello");
+
+  SnapshotWriter w2;
+  w2.write_string("!d1");
+  w2.write(SchemaHash<int>());
+  w2.write(std::string("hello"));
+  SnapshotReader r2(w2.data());
+  REQUIRE_THROWS(r2.read<std::unique_ptr<TBase>>());
+
+  // objects can only be written while recording
+  REQUIRE_THROWS(w.write(yaml::Create<TBase>(YAML::Load("!d1 hello"))));
+
+  // nested snapshots are moved into the snapshot of their owner
+  SnapshotRecorder recorder;
+  const auto obj = yaml::Create<TBase>(YAML::Load("!d2\na: !d1 hello\n"));
+  REQUIRE_THROWS_AS(recorder.find(dynamic_cast<TDerived2 &>(*obj).x.at("a").get()), SnapshotError);
+  SnapshotWriter w3;
+  w3.write(obj);
+  REQUIRE_THROWS_AS(recorder.find(obj.get()), SnapshotError);
+  SnapshotReader r3(w3.data());
+  REQUIRE(r3.read<std::unique_ptr<TBase>>()->id() == "a=hello,");
+}
+
+TEST_CASE("SnapshotNestedSchema")
+{
+  const auto vector_schema = SchemaHash<std::vector<TNested>>();
+  const auto map_schema    = SchemaHash<std::map<int, TNested>>();
+  const auto pair_schema   = SchemaHash<std::pair<int, std::optional<TNested>>>();
+
+  const auto dir      = std::filesystem::temp_directory_path();
+  const auto path     = dir / "ezconfig_test_snapshot_nested.yaml";
+  const auto snapshot = dir / "ezconfig_test_snapshot_nested.bin";
+  std::filesystem::remove(snapshot);
+  std::ofstream(path) << "!d2\na: !d5 [1, 2]\n";
+
+  LoadStats stats;
+  REQUIRE(yaml::LoadFileCached<TBase>(path, snapshot, &stats)->id() == "a=1,2,,");
+  REQUIRE(!stats.snapshot);
+  REQUIRE(yaml::LoadFileCached<TBase>(path, snapshot, &stats)->id() == "a=1,2,,");
+  REQUIRE(stats.snapshot);
+
+  // a change to the serializer of a nested type invalidates the snapshot
+  Serializer<TNested>::version = 2;
+  REQUIRE(SchemaHash<std::vector<TNested>>() != vector_schema);
+  REQUIRE(SchemaHash<std::map<int, TNested>>() != map_schema);
+  REQUIRE(SchemaHash<std::pair<int, std::optional<TNested>>>() != pair_schema);
+
+  REQUIRE(yaml::LoadFileCached<TBase>(path, snapshot, &stats)->id() == "a=1,2,,");
+  REQUIRE(!stats.snapshot);
+  REQUIRE(yaml::LoadFileCached<TBase>(path, snapshot, &stats)->id() == "a=1,2,,");
+  REQUIRE(stats.snapshot);
+
+  Serializer<TNested>::version = 1;
+  std::filesystem::remove(snapshot);
+  std::filesystem::remove(path);
+}
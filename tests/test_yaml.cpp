@@ -1,8 +1,12 @@
 // Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
 
+#include <filesystem>
+#include <fstream>
+
 #include <catch2/catch_test_macros.hpp>
 
 #include "ezconfig/yaml.hpp"
+#include "ezconfig/yaml_types/stl.hpp"
 
 using namespace ezconfig;
 
@@ -56,9 +60,42 @@ struct YAML::convert<TDerived3>
   }
 };
 
+struct TDerived4 : public TBase
+{
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  TDerived4(std::pmr::vector<std::pmr::string> && v, const allocator_type & alloc = {}) : x(std::move(v), alloc) {}
+
+  std::pmr::vector<std::pmr::string> x;
+  virtual std::string id() { return std::to_string(x.size()); }
+};
+
 EZ_YAML_REGISTER(TBase, "!d1", TDerived1, std::string);
 EZ_YAML_REGISTER(TBase, "!d2", TDerived2, int);
 EZ_YAML_REGISTER(TBase, "!d3", TDerived3);
+EZ_YAML_REGISTER(TBase, "!d4", TDerived4, std::pmr::vector<std::pmr::string>);
+
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+  std::size_t allocated{0};
+  std::size_t deallocated{0};
+
+private:
+  void * do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    allocated += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void * p, std::size_t bytes, std::size_t alignment) override
+  {
+    deallocated += bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override { return this == &other; }
+};
 
 TEST_CASE("YamlCreate")
 {
@@ -87,6 +124,11 @@ TEST_CASE("YamlInvalidTag2")
   REQUIRE_THROWS_AS(f(), std::logic_error);
 }
 
+// checked at compile time in EZ_YAML_REGISTER
+static_assert(yaml::IsValidTag("!d1"));
+static_assert(!yaml::IsValidTag("d1"));
+static_assert(!yaml::IsValidTag("!"));
+
 TEST_CASE("YamlAsUnique")
 {
   std::string yaml_str{
@@ -126,3 +168,54 @@ TEST_CASE("YamlAsVector")
   REQUIRE(vec[1]->id() == "holla");
   REQUIRE(vec[2]->id() == "4321234");
 }
+
+TEST_CASE("YamlCreatePmr")
+{
+  CountingResource resource;
+
+  {
+    auto d1 = yaml::Create<TBase>(YAML::Load("!d1 hello"), &resource);
+    REQUIRE(d1->id() == "hello");
+    REQUIRE(resource.allocated == sizeof(TDerived1));
+  }
+  REQUIRE(resource.deallocated == resource.allocated);
+
+  {
+    // members are allocated from the resource as well
+    auto d4 = yaml::Create<TBase>(YAML::Load("!d4 [a long string that does not fit in the sso buffer]"), &resource);
+    REQUIRE(d4->id() == "1");
+    REQUIRE(resource.allocated > sizeof(TDerived1) + sizeof(TDerived4) + sizeof(std::pmr::string));
+  }
+  REQUIRE(resource.deallocated == resource.allocated);
+}
+
+TEST_CASE("YamlArena")
+{
+  Arena arena;
+
+  auto * d1 = arena.own(yaml::Create<TBase>(YAML::Load("!d1 hello"), arena.resource()));
+  auto * d4 = arena.own(yaml::Create<TBase>(YAML::Load("!d4 [a, b, c]"), arena.resource()));
+  REQUIRE(d1->id() == "hello");
+  REQUIRE(d4->id() == "3");
+
+  arena.clear();
+}
+
+TEST_CASE("YamlLoadFile")
+{
+  const auto path = std::filesystem::temp_directory_path() / "ezconfig_test_load_file.yaml";
+  std::ofstream(path) << "!d3\nx: 1\ny: 2\n";
+
+  LoadStats stats;
+  auto d3 = yaml::LoadFile<TBase>(path, &stats);
+  REQUIRE(d3->id() == "3");
+  REQUIRE(stats.bytes == 14);
+  REQUIRE(stats.mapped);
+
+  // empty files are read into a buffer
+  std::ofstream(path, std::ios::trunc).close();
+  REQUIRE_THROWS(yaml::LoadFile<TBase>(path, &stats));
+
+  std::filesystem::remove(path);
+  REQUIRE_THROWS_AS(yaml::LoadFile<TBase>(path), std::system_error);
+}
@@ -1,10 +1,17 @@
 // Copyright (c) 2023 Petter Nilsson. MIT License. https://github.com/pettni/ezconfig
 
+#include <cmath>
+#include <memory_resource>
+#include <set>
+#include <tuple>
+#include <unordered_set>
+
 #include <boost/hana/adapt_struct.hpp>
 #include <boost/hana/tuple.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
+#include "ezconfig/yaml_types/decode.hpp"
 #include "ezconfig/yaml_types/eigen.hpp"
 #include "ezconfig/yaml_types/enum.hpp"
 #include "ezconfig/yaml_types/hana.hpp"
@@ -52,6 +59,37 @@ obj3: 3.23
   REQUIRE(obj["obj3"] == 3.23);
 }
 
+TEST_CASE("std_set_decode")
+{
+  REQUIRE(YAML::Load("[3, 1, 2]").as<std::set<int>>() == std::set<int>{1, 2, 3});
+  REQUIRE(YAML::Load("[b, a]").as<std::unordered_set<std::string>>() == std::unordered_set<std::string>{"a", "b"});
+  REQUIRE_THROWS_AS(YAML::Load("[1, 1]").as<std::set<int>>(), YAML::ParserException);
+  REQUIRE_THROWS_AS(YAML::Load("[1, 1]").as<std::unordered_set<int>>(), YAML::ParserException);
+  REQUIRE_THROWS_AS(YAML::Load("{a: 1}").as<std::set<int>>(), YAML::BadConversion);
+
+  REQUIRE(yaml_to_str(YAML::Node(std::set<int>{2, 1})) == "- 1\n- 2");
+}
+
+TEST_CASE("std_tuple")
+{
+  using Tuple = std::tuple<int, std::string, double>;
+  REQUIRE(YAML::Load("[1, a, 2.5]").as<Tuple>() == Tuple{1, "a", 2.5});
+  REQUIRE_THROWS_AS(YAML::Load("[1, a]").as<Tuple>(), YAML::BadConversion);
+  REQUIRE(yaml_to_str(YAML::Node(Tuple{1, "a", 2.5})) == "- 1\n- a\n- 2.5");
+}
+
+TEST_CASE("std_container_fast_path")
+{
+  using ezconfig::yaml::As;
+
+  const auto map = As<std::map<std::string, std::vector<int>>>(YAML::Load("{b: [1, 2], a: [], b: [3]}"));
+  REQUIRE(map == std::map<std::string, std::vector<int>>{{"a", {}}, {"b", {3}}});
+  REQUIRE(As<std::array<double, 2>>(YAML::Load("[1, 2]")) == std::array<double, 2>{1, 2});
+  REQUIRE(As<std::pair<int, std::string>>(YAML::Load("[1, a]")) == std::pair<int, std::string>{1, "a"});
+  REQUIRE_THROWS_AS((As<std::array<double, 2>>(YAML::Load("[1, 2, 3]"))), YAML::BadConversion);
+  REQUIRE_THROWS_AS((YAML::Load("{a: 1, a: 2}").as<std::unordered_map<std::string, int>>()), YAML::ParserException);
+}
+
 TEST_CASE("std_map_encode")
 {
   std::map<std::string, int> obj1{
@@ -158,6 +196,41 @@ TEST_CASE("stl_chrono")
   REQUIRE(YAML::Load("5m").as<std::chrono::minutes>() == 300s);
   REQUIRE(YAML::Load("5h").as<std::chrono::hours>() == 5h);
   REQUIRE(YAML::Load("5h").as<std::chrono::nanoseconds>() == 5h);
+
+  REQUIRE(YAML::Load("1.5s").as<std::chrono::milliseconds>() == 1500ms);
+  REQUIRE(YAML::Load("1m30s").as<std::chrono::seconds>() == 90s);
+  REQUIRE(YAML::Load("-1h0.5m").as<std::chrono::seconds>() == -3630s);
+  REQUIRE(YAML::Load("0.0000000019s").as<std::chrono::nanoseconds>() == 1ns);
+  REQUIRE(YAML::Load("0").as<std::chrono::seconds>() == 0s);
+  REQUIRE(YAML::Load("1.5s").as<std::chrono::duration<double>>().count() == 1.5);
+  REQUIRE(YAML::Load("250ms").as<std::chrono::duration<float>>().count() == 0.25f);
+  REQUIRE(YAML::Load("1h30m").as<std::chrono::duration<double, std::ratio<3600>>>().count() == 1.5);
+  REQUIRE(YAML::Load("99999999999999999999s").as<std::chrono::duration<double>>().count() == 1e20);
+
+  REQUIRE_THROWS_AS(YAML::Load("5").as<std::chrono::seconds>(), YAML::ParserException);
+  REQUIRE_THROWS_AS(YAML::Load("5 s").as<std::chrono::seconds>(), YAML::ParserException);
+  REQUIRE_THROWS_AS(YAML::Load("1s-1s").as<std::chrono::seconds>(), YAML::ParserException);
+  REQUIRE_THROWS_AS(YAML::Load(".s").as<std::chrono::seconds>(), YAML::ParserException);
+  REQUIRE_THROWS_AS(YAML::Load("3000000h").as<std::chrono::nanoseconds>(), YAML::ParserException);
+  REQUIRE_THROWS_AS(YAML::Load("1000000h").as<std::chrono::duration<int32_t>>(), YAML::ParserException);
+  REQUIRE_THROWS_AS(YAML::Load("99999999999999999999s").as<std::chrono::seconds>(), YAML::ParserException);
+  REQUIRE_THROWS_AS(
+    YAML::Load(std::string(400, '9') + "s").as<std::chrono::duration<double>>(), YAML::ParserException);
+  REQUIRE_THROWS_AS(
+    YAML::Load(std::string(50, '9') + "s").as<std::chrono::duration<float>>(), YAML::ParserException);
+}
+
+TEST_CASE("stl_chrono_encode")
+{
+  using namespace std::chrono_literals;
+
+  REQUIRE(yaml_to_str(YAML::Node(40ms)) == "40ms");
+  REQUIRE(yaml_to_str(YAML::Node(-3h)) == "-3h");
+  REQUIRE(yaml_to_str(YAML::Node(std::chrono::duration<double>(0.1))) == "0.1s");
+  REQUIRE(yaml_to_str(YAML::Node(std::chrono::duration<int64_t, std::ratio<1, 3>>(1))) == "333333333ns");
+
+  const auto d = std::chrono::duration<double, std::milli>(1.0 / 3);
+  REQUIRE(YAML::Node(d).as<std::chrono::duration<double, std::milli>>() == d);
 }
 
 TEST_CASE("stl_filesystem")
@@ -165,6 +238,25 @@ TEST_CASE("stl_filesystem")
   REQUIRE(YAML::Load("my/file").as<std::filesystem::path>() == std::filesystem::path("my/file"));
 }
 
+TEST_CASE("stl_pmr")
+{
+  std::pmr::monotonic_buffer_resource resource;
+
+  std::pmr::vector<std::pmr::string> vec(&resource);
+  YAML::convert<std::pmr::vector<std::pmr::string>>::decode(YAML::Load("[a, b, c]"), vec);
+  REQUIRE(vec == std::pmr::vector<std::pmr::string>{"a", "b", "c"});
+  REQUIRE(vec.get_allocator().resource() == &resource);
+  REQUIRE(vec[0].get_allocator().resource() == &resource);
+
+  std::pmr::unordered_map<std::pmr::string, int> map(&resource);
+  YAML::convert<std::pmr::unordered_map<std::pmr::string, int>>::decode(YAML::Load("{a: 1, b: 2}"), map);
+  REQUIRE(map.size() == 2);
+  REQUIRE(map.at("b") == 2);
+  REQUIRE(map.get_allocator().resource() == &resource);
+
+  REQUIRE(yaml_to_str(YAML::Node(std::pmr::string("hello"))) == std::string{"hello"});
+}
+
 struct MyStruct
 {
   MyVariant member1;
@@ -196,6 +288,68 @@ member3: null
   REQUIRE(data.member3 == std::nullopt);
 }
 
+struct MyStrictStruct
+{
+  int a;
+  double b;
+};
+
+BOOST_HANA_ADAPT_STRUCT(MyStrictStruct, a, b);
+
+template<>
+struct ezconfig::hana_strict_keys<MyStrictStruct> : std::true_type
+{};
+
+TEST_CASE("boost_hana_keys")
+{
+  // unknown keys are ignored, the first occurrence of a key is used
+  const auto data = YAML::Load("{member3: abc, member1: !int 1, unknown: 2, member2: [], member3: def}").as<MyStruct>();
+  REQUIRE(data.member1 == MyVariant(1));
+  REQUIRE(data.member3 == "abc");
+
+  REQUIRE_THROWS_AS(YAML::Load("{member1: !int 1, member2: []}").as<MyStruct>(), YAML::ParserException);
+  REQUIRE_THROWS(YAML::Load("[1, 2, 3]").as<MyStruct>());
+
+  const auto strict = YAML::Load("{b: 2.5, a: 1}").as<MyStrictStruct>();
+  REQUIRE(strict.a == 1);
+  REQUIRE(strict.b == 2.5);
+  REQUIRE_THROWS_AS(YAML::Load("{a: 1, b: 2.5, c: 3}").as<MyStrictStruct>(), YAML::ParserException);
+}
+
+TEST_CASE("number_fast_path")
+{
+  using ezconfig::yaml::As;
+
+  // same result as yaml-cpp
+  const auto strs = {"0", "-12", "017", "0x1f", "1.5", "-.25", "1e3", "+1.5", ".inf", "+.Inf", "-.INF", "1e400"};
+  for (const auto * str : strs) {
+    const auto yaml = YAML::Load(str);
+    if (yaml.IsScalar() && std::string_view(str).find_first_of(".e") == std::string_view::npos) {
+      REQUIRE(As<int>(yaml) == yaml.as<int>());
+      REQUIRE(As<long>(yaml) == yaml.as<long>());
+    }
+    try {
+      const auto expected = yaml.as<double>();
+      REQUIRE(As<double>(yaml) == expected);
+    } catch (const YAML::BadConversion &) {
+      REQUIRE_THROWS_AS(As<double>(yaml), YAML::BadConversion);
+    }
+  }
+  REQUIRE(std::isnan(As<double>(YAML::Load(".nan"))));
+  REQUIRE(std::isnan(As<float>(YAML::Load(".NaN"))));
+
+  REQUIRE_THROWS_AS(As<int>(YAML::Load("1.5")), YAML::BadConversion);
+  REQUIRE_THROWS_AS(As<int>(YAML::Load("99999999999")), YAML::BadConversion);
+  REQUIRE_THROWS_AS(As<unsigned>(YAML::Load("-1")), YAML::BadConversion);
+  REQUIRE_THROWS_AS(As<double>(YAML::Load("nan")), YAML::BadConversion);
+  REQUIRE_THROWS_AS(As<double>(YAML::Load("inf")), YAML::BadConversion);
+  REQUIRE_THROWS_AS(As<double>(YAML::Load("[1]")), YAML::BadConversion);
+
+  REQUIRE(As<std::vector<double>>(YAML::Load("[1, 2.5, .inf]")) == std::vector<double>{1, 2.5, INFINITY});
+  REQUIRE(As<std::vector<int>>(YAML::Load("[1, 0x10]")) == std::vector<int>{1, 16});
+  REQUIRE_THROWS_AS(As<std::vector<int>>(YAML::Load("[1, a]")), YAML::BadConversion);
+}
+
 TEST_CASE("eigen_vec_static")
 {
   REQUIRE(YAML::Load("[1., 2., 3.]").as<Eigen::Vector3d>().isApprox(Eigen::Vector3d{1, 2, 3}));
@@ -243,6 +397,11 @@ TEST_CASE("eigen_mat_empty") { REQUIRE_THROWS_AS(YAML::Load("[]").as<Eigen::Matr
 TEST_CASE("eigen_mat_wrongsize")
 {
   REQUIRE_THROWS_AS(YAML::Load("[[1., 2., 3.], [4., 5.]]").as<Eigen::MatrixXd>(), YAML::ParserException);
+  REQUIRE_THROWS_AS(YAML::Load("[[1., 2., 3.], 4.]").as<Eigen::MatrixXd>(), YAML::ParserException);
+
+  using Mat23 = Eigen::Matrix<double, 2, 3>;
+  REQUIRE_THROWS_AS(YAML::Load("[[1., 2.], [4., 5.]]").as<Mat23>(), YAML::ParserException);
+  REQUIRE_THROWS_AS(YAML::Load("[[1., 2., 3.]]").as<Mat23>(), YAML::ParserException);
 }
 
 TEST_CASE("eigen_quat")
@@ -302,6 +461,64 @@ orientation:
     smooth::SE3d(smooth::SO3d{Eigen::Quaterniond{0, 0, 0, 1}}, Eigen::Vector3d{1, -1, 1})));
 }
 
+TEST_CASE("smooth_trajectory")
+{
+  auto traj_str = R"(
+- {x: 1., y: 2., z: 3., qw: 1., qx: 0., qy: 0., qz: 0.}
+- {qz: 1., qy: 0., qx: 0., qw: 0., z: -3., y: -2., x: -1.}
+- translation: [4., 5., 6.]
+  orientation: {w: 0., x: 1., y: 0., z: 0.}
+- translation: {x: 7., y: 8., z: 9.}
+  orientation: {qw: 0., qx: 0., qy: 1., qz: 0.}
+  )";
+
+  const std::vector<smooth::SE3d> expected{
+    smooth::SE3d(smooth::SO3d{Eigen::Quaterniond{1, 0, 0, 0}}, Eigen::Vector3d{1, 2, 3}),
+    smooth::SE3d(smooth::SO3d{Eigen::Quaterniond{0, 0, 0, 1}}, Eigen::Vector3d{-1, -2, -3}),
+    smooth::SE3d(smooth::SO3d{Eigen::Quaterniond{0, 1, 0, 0}}, Eigen::Vector3d{4, 5, 6}),
+    smooth::SE3d(smooth::SO3d{Eigen::Quaterniond{0, 0, 1, 0}}, Eigen::Vector3d{7, 8, 9}),
+  };
+
+  const auto yaml = YAML::Load(traj_str);
+  const auto aos  = ezconfig::yaml::As<std::vector<smooth::SE3d>>(yaml);
+  const auto soa  = yaml.as<ezconfig::SE3Trajectory<double>>();
+  REQUIRE(aos.size() == expected.size());
+  REQUIRE(soa.size() == expected.size());
+  for (auto i = 0u; i < expected.size(); ++i) {
+    REQUIRE(aos[i].isApprox(expected[i]));
+    REQUIRE(soa[i].isApprox(expected[i]));
+  }
+
+  // layout detected from a nested pose
+  YAML::Node nested;
+  nested.push_back(yaml[2]);
+  nested.push_back(yaml[3]);
+  const auto nested_soa = nested.as<ezconfig::SE3Trajectory<double>>();
+  REQUIRE(nested_soa.size() == 2);
+  REQUIRE(nested_soa[0].isApprox(expected[2]));
+  REQUIRE(nested_soa[1].isApprox(expected[3]));
+
+  // round trip
+  const auto aos_copy = ezconfig::yaml::As<std::vector<smooth::SE3d>>(YAML::Load(YAML::Dump(YAML::Node(aos))));
+  const auto soa_copy = YAML::Load(YAML::Dump(YAML::Node(soa))).as<ezconfig::SE3Trajectory<double>>();
+  REQUIRE(aos_copy.size() == expected.size());
+  for (auto i = 0u; i < expected.size(); ++i) {
+    REQUIRE(aos_copy[i].isApprox(aos[i]));
+    REQUIRE(soa_copy[i].isApprox(soa[i]));
+  }
+  REQUIRE(YAML::Node(expected[0])["qw"].as<double>() == 1.);
+
+  REQUIRE(ezconfig::yaml::As<std::vector<smooth::SE3d>>(YAML::Load("[]")).empty());
+  REQUIRE(YAML::Load("[]").as<ezconfig::SE3Trajectory<double>>().size() == 0);
+  REQUIRE_THROWS(ezconfig::yaml::As<std::vector<smooth::SE3d>>(YAML::Load("{x: 1.}")));
+  REQUIRE_THROWS(ezconfig::yaml::As<std::vector<smooth::SE3d>>(
+    YAML::Load("[{x: 1., y: 2., z: 3., qw: 1., qx: 0., qy: 0., qz: a}]")));
+
+  // yaml-cpp's own vector conversion decodes pose by pose with the same result
+  const auto aos_yaml = yaml.as<std::vector<smooth::SE3d>>();
+  for (auto i = 0u; i < expected.size(); ++i) { REQUIRE(aos_yaml[i].isApprox(expected[i])); }
+}
+
 enum class TestEnum {
   VALUE_1,
   VALUE_2,
@@ -313,4 +530,45 @@ TEST_CASE("enum")
   REQUIRE(YAML::Load("VALUE_1").as<TestEnum>() == TestEnum::VALUE_1);
   REQUIRE(YAML::Load("VALUE_3").as<TestEnum>() == TestEnum::VALUE_3);
   REQUIRE_THROWS(YAML::Load("VALUE_4").as<TestEnum>());
+  REQUIRE_THROWS(YAML::Load("value_1").as<TestEnum>());
+  REQUIRE_THROWS(YAML::Load("[VALUE_1]").as<TestEnum>());
+}
+
+enum class TestCaseEnum {
+  Red,
+  Green,
+  DarkBlue = 10,
+};
+
+template<>
+struct ezconfig::enum_case_insensitive<TestCaseEnum> : std::true_type
+{};
+
+// magic_enum behavior that the enum conversions rely on
+static_assert(magic_enum::enum_names<TestCaseEnum>()[2] == "DarkBlue");
+static_assert(magic_enum::enum_values<TestCaseEnum>()[2] == TestCaseEnum::DarkBlue);
+static_assert(magic_enum::enum_name(static_cast<TestCaseEnum>(5)).empty());
+
+TEST_CASE("enum_case_insensitive")
+{
+  REQUIRE(YAML::Load("Red").as<TestCaseEnum>() == TestCaseEnum::Red);
+  REQUIRE(YAML::Load("GREEN").as<TestCaseEnum>() == TestCaseEnum::Green);
+  REQUIRE(YAML::Load("darkblue").as<TestCaseEnum>() == TestCaseEnum::DarkBlue);
+  REQUIRE_THROWS(YAML::Load("dark_blue").as<TestCaseEnum>());
+  REQUIRE_THROWS(YAML::Load("darkblueish").as<TestCaseEnum>());
+}
+
+TEST_CASE("enum_encode")
+{
+  REQUIRE(YAML::Node(TestEnum::VALUE_2).as<std::string>() == "VALUE_2");
+  REQUIRE(YAML::Node(TestCaseEnum::DarkBlue).as<std::string>() == "DarkBlue");
+  REQUIRE(YAML::Node(static_cast<TestCaseEnum>(5)).as<int>() == 5);
+
+  const auto unnamed = static_cast<TestCaseEnum>(5);
+  REQUIRE(YAML::Load(YAML::Dump(YAML::Node(unnamed))).as<TestCaseEnum>() == unnamed);
+  REQUIRE(YAML::Load("10").as<TestCaseEnum>() == TestCaseEnum::DarkBlue);
+
+  for (const auto val : {TestEnum::VALUE_1, TestEnum::VALUE_2, TestEnum::VALUE_3}) {
+    REQUIRE(YAML::Load(YAML::Dump(YAML::Node(val))).as<TestEnum>() == val);
+  }
 }